@@ -0,0 +1,294 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__AWAITABLE_HPP_
+#define MESSAGE_FILTERS__AWAITABLE_HPP_
+
+// The awaitable adapters need C++20 coroutines; without them this header provides nothing, and
+// filters and synchronizers are used through their callbacks as usual.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && \
+  __has_include(<coroutine>)
+#define MESSAGE_FILTERS_HAS_COROUTINES 1
+
+#include <cassert>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+#include "message_filters/connection.hpp"
+#include "message_filters/message_event.hpp"
+#include "message_filters/ring_buffer.hpp"
+
+namespace message_filters
+{
+
+/**
+ * \brief Runs the function it is given, now or later and on any thread, e.g. by posting it to
+ * an executor's queue.
+ */
+typedef std::function<void (std::function<void()>)> AwaitExecutor;
+
+/**
+ * \brief Queue of values that a coroutine can wait on with co_await next().
+ *
+ * Values pushed while no coroutine is waiting are queued; once more than queue_size are queued,
+ * the oldest is discarded, see getDropCount(). A coroutine waiting in next() when a value is
+ * pushed is resumed with it, by default right away on the pushing thread, or through the
+ * AwaitExecutor given to next().
+ *
+ * A single coroutine may wait at a time, and the queue must outlive any wait.
+ */
+template<class T>
+class AwaitableQueue : public noncopyable
+{
+public:
+  class Awaiter
+  {
+public:
+    bool await_ready() const
+    {
+      // Checked by await_suspend(), under the lock
+      return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+      return queue_->suspend(this, handle);
+    }
+
+    T await_resume()
+    {
+      return std::move(value_);
+    }
+
+private:
+    friend class AwaitableQueue;
+
+    Awaiter(AwaitableQueue * queue, AwaitExecutor executor)
+    : queue_(queue)
+      , executor_(std::move(executor))
+    {
+    }
+
+    AwaitableQueue * queue_;
+    AwaitExecutor executor_;
+    std::coroutine_handle<> handle_;
+    T value_;
+  };
+
+  /**
+   * \param queue_size The maximum number of values queued while no coroutine waits, 0 for
+   *        unbounded.
+   */
+  explicit AwaitableQueue(uint32_t queue_size = 0)
+  : queue_size_(queue_size)
+    , drop_count_(0)
+    , waiter_(nullptr)
+  {
+  }
+
+  /**
+   * \brief co_await the result to get the next value.
+   *
+   * \param executor How to resume the coroutine if it has to wait; by default it is resumed on
+   *        the thread that pushes the value.
+   */
+  Awaiter next(AwaitExecutor executor = AwaitExecutor())
+  {
+    return Awaiter(this, std::move(executor));
+  }
+
+  void push(const T & value)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!waiter_) {
+      queue_.push_back(value);
+      if (queue_size_ > 0 && queue_.size() > queue_size_) {
+        queue_.pop_front();
+        ++drop_count_;
+      }
+      return;
+    }
+
+    Awaiter * waiter = waiter_;
+    waiter_ = nullptr;
+    waiter->value_ = value;
+    // The awaiter is gone as soon as the coroutine resumes
+    std::coroutine_handle<> handle = waiter->handle_;
+    AwaitExecutor executor = std::move(waiter->executor_);
+    lock.unlock();
+
+    if (executor) {
+      executor([handle]() {handle.resume();});
+    } else {
+      handle.resume();
+    }
+  }
+
+  /**
+   * \brief The number of values queued, not yet taken by next().
+   */
+  size_t size()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+  }
+
+  /**
+   * \brief The number of values discarded because the queue was full.
+   */
+  uint64_t getDropCount()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return drop_count_;
+  }
+
+private:
+  // Hands the oldest queued value to <waiter> if there is one, else makes it wait for the next.
+  // Returns whether the coroutine is suspended.
+  bool suspend(Awaiter * waiter, std::coroutine_handle<> handle)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!queue_.empty()) {
+      waiter->value_ = std::move(queue_.front());
+      queue_.pop_front();
+      return false;
+    }
+    assert(!waiter_ && "only one coroutine may wait at a time");
+    waiter->handle_ = handle;
+    waiter_ = waiter;
+    return true;
+  }
+
+  uint32_t queue_size_;
+
+  // Everything below is protected by mutex_
+  std::mutex mutex_;
+  RingBuffer<T> queue_;
+  uint64_t drop_count_;
+  Awaiter * waiter_;  // The suspended coroutine's, if any
+};
+
+/**
+ * \brief Lets a coroutine wait for the events of a filter.
+\verbatim
+message_filters::AwaitableFilter<Image> images(image_sub);
+while (true) {
+  message_filters::MessageEvent<Image const> event = co_await images.next();
+  ...
+}
+\endverbatim
+ */
+template<class M>
+class AwaitableFilter : public AwaitableQueue<MessageEvent<M const>>
+{
+public:
+  typedef MessageEvent<M const> EventType;
+
+  /**
+   * \param f The filter whose output to wait on
+   * \param queue_size The maximum number of events queued while no coroutine waits, 0 for
+   *        unbounded.
+   */
+  template<class F>
+  explicit AwaitableFilter(F & f, uint32_t queue_size = 0)
+  : AwaitableQueue<EventType>(queue_size)
+  {
+    connection_ = f.registerCallback(
+      std::function<void(const EventType &)>(
+        [this](const EventType & evt) {
+          this->push(evt);
+        }));
+  }
+
+  ~AwaitableFilter()
+  {
+    connection_.disconnect();
+  }
+
+private:
+  Connection connection_;
+};
+
+/**
+ * \brief Lets a coroutine wait for the tuples of a Synchronizer.
+\verbatim
+message_filters::AwaitableSynchronizer<Sync> tuples(sync);
+while (true) {
+  Sync::Events events = co_await tuples.next();
+  ...
+}
+\endverbatim
+ */
+template<class Sync>
+class AwaitableSynchronizer : public AwaitableQueue<typename Sync::Events>
+{
+public:
+  typedef typename Sync::Events Events;
+
+  /**
+   * \param sync The synchronizer whose tuples to wait on
+   * \param queue_size The maximum number of tuples queued while no coroutine waits, 0 for
+   *        unbounded.
+   */
+  explicit AwaitableSynchronizer(Sync & sync, uint32_t queue_size = 0)
+  : AwaitableQueue<Events>(queue_size)
+  {
+    connection_ = sync.registerCallback(
+      std::function<void(
+        const typename Sync::M0Event &, const typename Sync::M1Event &,
+        const typename Sync::M2Event &, const typename Sync::M3Event &,
+        const typename Sync::M4Event &, const typename Sync::M5Event &,
+        const typename Sync::M6Event &, const typename Sync::M7Event &,
+        const typename Sync::M8Event &)>(
+        [this](
+          const typename Sync::M0Event & e0, const typename Sync::M1Event & e1,
+          const typename Sync::M2Event & e2, const typename Sync::M3Event & e3,
+          const typename Sync::M4Event & e4, const typename Sync::M5Event & e5,
+          const typename Sync::M6Event & e6, const typename Sync::M7Event & e7,
+          const typename Sync::M8Event & e8) {
+          this->push(Events(e0, e1, e2, e3, e4, e5, e6, e7, e8));
+        }));
+  }
+
+  ~AwaitableSynchronizer()
+  {
+    connection_.disconnect();
+  }
+
+private:
+  Connection connection_;
+};
+
+}  // namespace message_filters
+
+#endif  // __cpp_impl_coroutine
+
+#endif  // MESSAGE_FILTERS__AWAITABLE_HPP_
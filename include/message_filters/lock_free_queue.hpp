@@ -0,0 +1,197 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__LOCK_FREE_QUEUE_HPP_
+#define MESSAGE_FILTERS__LOCK_FREE_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace message_filters
+{
+
+/**
+ * \brief Bounded, lock-free, multi-producer queue.
+ *
+ * A ring of cells, each tagged with a sequence number that tells producers and consumers whether
+ * the cell is free or holds a value for the current lap around the ring. Producers and consumers
+ * only ever contend on a single atomic position each, and never wait on one another: tryPush()
+ * fails when the queue is full and tryPop() fails when it is empty.
+ *
+ * The storage is allocated once at construction, so pushing and popping never allocate.
+ *
+ * Any number of threads may push and pop concurrently. front() may only be used when there is a
+ * single consumer, since another consumer could pop the element it points to.
+ */
+template<typename T>
+class LockFreeQueue
+{
+public:
+  /**
+   * \param capacity The minimum number of elements the queue can hold. It is rounded up to the
+   *        next power of two.
+   */
+  explicit LockFreeQueue(size_t capacity)
+  : capacity_(roundUpToPowerOfTwo(capacity))
+    , mask_(capacity_ - 1)
+    , cells_(new Cell[capacity_])
+  {
+    for (size_t i = 0; i < capacity_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  LockFreeQueue(const LockFreeQueue &) = delete;
+  LockFreeQueue & operator=(const LockFreeQueue &) = delete;
+
+  /**
+   * \brief Append a copy of \p value, unless the queue is full.
+   * \return false if the queue was full, in which case nothing was added
+   */
+  bool tryPush(const T & value)
+  {
+    size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    Cell * cell;
+    for (;;) {
+      cell = &cells_[position & mask_];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      intptr_t lap = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+      if (lap == 0) {
+        // The cell is free for this lap, claim it
+        if (enqueue_position_.compare_exchange_weak(
+            position, position + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      } else if (lap < 0) {
+        // The cell still holds the value of the previous lap: the queue is full
+        return false;
+      } else {
+        // Another producer claimed the cell first, retry at the new position
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = value;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief Move the oldest element into \p value, unless the queue is empty.
+   * \return false if the queue was empty, in which case \p value is untouched
+   */
+  bool tryPop(T & value)
+  {
+    size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    Cell * cell;
+    for (;;) {
+      cell = &cells_[position & mask_];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      intptr_t lap = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+      if (lap == 0) {
+        // The cell holds a value for this lap, claim it
+        if (dequeue_position_.compare_exchange_weak(
+            position, position + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      } else if (lap < 0) {
+        // The cell has not been written yet: the queue is empty
+        return false;
+      } else {
+        // Another consumer claimed the cell first, retry at the new position
+        position = dequeue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(cell->value);
+    // Do not keep the popped value alive until the cell is reused
+    cell->value = T();
+    cell->sequence.store(position + capacity_, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief The oldest element, or nullptr if the queue is empty.
+   *
+   * Only valid with a single consumer; the element stays valid until that consumer pops it.
+   */
+  const T * front() const
+  {
+    size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    const Cell & cell = cells_[position & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+      return nullptr;
+    }
+    return &cell.value;
+  }
+
+  /**
+   * \brief Whether the queue looked empty at the time of the call.
+   */
+  bool empty() const
+  {
+    return enqueue_position_.load(std::memory_order_acquire) ==
+           dequeue_position_.load(std::memory_order_acquire);
+  }
+
+  size_t capacity() const
+  {
+    return capacity_;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static size_t roundUpToPowerOfTwo(size_t n)
+  {
+    size_t power = 1;
+    while (power < n) {
+      power <<= 1;
+    }
+    return power;
+  }
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+
+  // Kept on separate cache lines so that producers and consumers do not false share
+  alignas(64) std::atomic<size_t> enqueue_position_{0};
+  alignas(64) std::atomic<size_t> dequeue_position_{0};
+};
+
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__LOCK_FREE_QUEUE_HPP_
@@ -101,6 +101,14 @@ struct TimeStamp<M, typename std::enable_if<HasHeader<M>::value>::type>
   }
 };
 
+/**
+ * \brief MatchKey trait, the key the ExactKey policy matches messages on.  There is no default
+ * implementation: it must be specialized with a static value() returning a uint64_t, for instance
+ * a frame counter or sequence number carried by the message.
+ */
+template<typename M, typename Enable = void>
+struct MatchKey;
+
 }  // namespace message_traits
 }  // namespace message_filters
 
@@ -0,0 +1,207 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__QUEUE_SIZE_TUNER_HPP_
+#define MESSAGE_FILTERS__QUEUE_SIZE_TUNER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace message_filters
+{
+
+/**
+ * \brief Estimates the smallest queue sizes a synchronizer needs to avoid dropping messages.
+ *
+ * The period of each input is tracked as a moving average of the gaps between its stamps, and
+ * its lag as how far its stamps trail the newest stamp seen on any input when they arrive. A
+ * message must be kept until the input lagging the most has caught up with it, and then until
+ * the next message of the slowest input has arrived, so the time span to keep is the largest lag
+ * plus the largest period. Each input's queue size is that span divided by its own period.
+ *
+ * Peak lags are followed at once but decay by one sixteenth of the stamp time elapsed, so that
+ * the sizes shrink back slowly once a burst of latency is over.
+ *
+ * Not thread safe: the policies call it under their own lock.
+ */
+class QueueSizeTuner
+{
+public:
+  static constexpr size_t MAX_INPUTS = 9;
+
+  /**
+   * \param inputs The number of inputs of the synchronizer.
+   * \param min_size The smallest queue size returned.
+   * \param max_size The largest queue size returned.
+   */
+  explicit QueueSizeTuner(
+    size_t inputs = 0, uint32_t min_size = 1,
+    uint32_t max_size = std::numeric_limits<uint32_t>::max())
+  : input_count_(inputs)
+    , min_size_(min_size)
+    , max_size_(max_size)
+  {
+    assert(input_count_ <= MAX_INPUTS);
+    assert(min_size_ > 0 && min_size_ <= max_size_);
+  }
+
+  /**
+   * \brief Records the arrival of a message of input \p i stamped \p stamp (in nanoseconds).
+   */
+  void observe(size_t i, int64_t stamp)
+  {
+    assert(i < input_count_);
+    Input & input = inputs_[i];
+    if (input.count > 0 && stamp > input.last_stamp) {
+      const int64_t gap = stamp - input.last_stamp;
+      input.period = input.period == 0 ? gap : input.period + (gap - input.period) / 8;
+    }
+    if (input.count == 0 || stamp > input.last_stamp) {
+      input.last_stamp = stamp;
+    }
+    ++input.count;
+
+    if (!has_newest_stamp_ || stamp > newest_stamp_) {
+      if (has_newest_stamp_) {
+        const int64_t decay = (stamp - newest_stamp_) / 16;
+        for (size_t k = 0; k < input_count_; ++k) {
+          inputs_[k].peak_lag = std::max<int64_t>(0, inputs_[k].peak_lag - decay);
+        }
+      }
+      newest_stamp_ = stamp;
+      has_newest_stamp_ = true;
+    }
+    input.peak_lag = std::max(input.peak_lag, newest_stamp_ - stamp);
+  }
+
+  /**
+   * \brief Whether every input has received enough messages for the sizes to be estimated.
+   */
+  bool ready() const
+  {
+    for (size_t k = 0; k < input_count_; ++k) {
+      if (inputs_[k].period == 0) {
+        return false;
+      }
+    }
+    return input_count_ > 0;
+  }
+
+  /**
+   * \brief The time span (in nanoseconds) the queues should cover, 0 if not ready().
+   */
+  int64_t span() const
+  {
+    if (!ready()) {
+      return 0;
+    }
+    int64_t lag = 0;
+    int64_t period = 0;
+    for (size_t k = 0; k < input_count_; ++k) {
+      lag = std::max(lag, inputs_[k].peak_lag);
+      period = std::max(period, inputs_[k].period);
+    }
+    return lag + period;
+  }
+
+  /**
+   * \brief The number of messages input \p i should keep, 0 if not ready().
+   */
+  uint32_t queueSize(size_t i) const
+  {
+    assert(i < input_count_);
+    return ready() ? clamp(span() / inputs_[i].period) : 0;
+  }
+
+  /**
+   * \brief The number of distinct stamps the queues should cover, 0 if not ready().
+   *
+   * This is the size to use for policies that keep one entry per stamp, such as ExactTime.
+   */
+  uint32_t stampCount() const
+  {
+    if (!ready()) {
+      return 0;
+    }
+    int64_t period = std::numeric_limits<int64_t>::max();
+    for (size_t k = 0; k < input_count_; ++k) {
+      period = std::min(period, inputs_[k].period);
+    }
+    return clamp(span() / period);
+  }
+
+  /**
+   * \brief The estimated period (in nanoseconds) of input \p i, 0 if not known yet.
+   */
+  int64_t period(size_t i) const
+  {
+    assert(i < input_count_);
+    return inputs_[i].period;
+  }
+
+  /**
+   * \brief The peak lag (in nanoseconds) of input \p i behind the newest stamp of all inputs.
+   */
+  int64_t lag(size_t i) const
+  {
+    assert(i < input_count_);
+    return inputs_[i].peak_lag;
+  }
+
+private:
+  struct Input
+  {
+    int64_t last_stamp{0};
+    int64_t period{0};
+    int64_t peak_lag{0};
+    uint64_t count{0};
+  };
+
+  // One for the message being added and one for the rounding of the quotient
+  uint32_t clamp(int64_t periods) const
+  {
+    const int64_t size = periods + 2;
+    return static_cast<uint32_t>(
+      std::clamp<int64_t>(size, min_size_, static_cast<int64_t>(max_size_)));
+  }
+
+  size_t input_count_;
+  uint32_t min_size_;
+  uint32_t max_size_;
+  std::array<Input, MAX_INPUTS> inputs_{};
+  int64_t newest_stamp_{0};
+  bool has_newest_stamp_{false};
+};
+
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__QUEUE_SIZE_TUNER_HPP_
@@ -0,0 +1,193 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__RING_BUFFER_HPP_
+#define MESSAGE_FILTERS__RING_BUFFER_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace message_filters
+{
+
+/**
+ * \brief FIFO queue stored in a single ring of contiguous slots.
+ *
+ * Pushing to the back and popping from the front are O(1) and never move the other elements.
+ * The ring doubles in size when it is full, so it only allocates while growing to the largest
+ * size it has held; popped slots are reused. The memory comes from a polymorphic allocator, so
+ * that the buffer can be part of a pooled container tuple.
+ *
+ * Not thread safe.
+ */
+template<typename T>
+class RingBuffer
+{
+public:
+  typedef std::pmr::polymorphic_allocator<T> allocator_type;
+
+  RingBuffer()
+  : RingBuffer(allocator_type())
+  {
+  }
+
+  explicit RingBuffer(const allocator_type & allocator)
+  : slots_(allocator)
+    , head_(0)
+    , size_(0)
+  {
+  }
+
+  RingBuffer(const RingBuffer & other, const allocator_type & allocator = allocator_type())
+  : slots_(allocator)
+    , head_(0)
+    , size_(0)
+  {
+    *this = other;
+  }
+
+  RingBuffer & operator=(const RingBuffer & rhs)
+  {
+    if (this == &rhs) {
+      return *this;
+    }
+    clear();
+    reserve(rhs.size_);
+    for (size_t i = 0; i < rhs.size_; ++i) {
+      push_back(rhs[i]);
+    }
+    return *this;
+  }
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+  bool empty() const
+  {
+    return size_ == 0;
+  }
+
+  size_t capacity() const
+  {
+    return slots_.size();
+  }
+
+  // Assumes the buffer is not empty
+  T & front()
+  {
+    assert(size_ > 0);
+    return slots_[head_];
+  }
+
+  const T & front() const
+  {
+    assert(size_ > 0);
+    return slots_[head_];
+  }
+
+  T & back()
+  {
+    assert(size_ > 0);
+    return (*this)[size_ - 1];
+  }
+
+  const T & back() const
+  {
+    assert(size_ > 0);
+    return (*this)[size_ - 1];
+  }
+
+  // The i-th oldest element
+  T & operator[](size_t i)
+  {
+    return slots_[(head_ + i) & (slots_.size() - 1)];
+  }
+
+  const T & operator[](size_t i) const
+  {
+    return slots_[(head_ + i) & (slots_.size() - 1)];
+  }
+
+  void push_back(const T & value)
+  {
+    if (size_ == slots_.size()) {
+      reserve(size_ + 1);
+    }
+    (*this)[size_] = value;
+    ++size_;
+  }
+
+  void pop_front()
+  {
+    assert(size_ > 0);
+    // Do not keep the popped element alive until its slot is reused
+    slots_[head_] = T();
+    head_ = (head_ + 1) & (slots_.size() - 1);
+    --size_;
+  }
+
+  void clear()
+  {
+    while (size_ > 0) {
+      pop_front();
+    }
+    head_ = 0;
+  }
+
+  // Makes room for at least <capacity> elements, rounded up to a power of two
+  void reserve(size_t capacity)
+  {
+    if (capacity <= slots_.size()) {
+      return;
+    }
+    size_t new_capacity = slots_.empty() ? 8 : slots_.size();
+    while (new_capacity < capacity) {
+      new_capacity <<= 1;
+    }
+    std::pmr::vector<T> slots(new_capacity, slots_.get_allocator());
+    for (size_t i = 0; i < size_; ++i) {
+      slots[i] = std::move((*this)[i]);
+    }
+    slots_.swap(slots);
+    head_ = 0;
+  }
+
+private:
+  std::pmr::vector<T> slots_;  // Its size is zero or a power of two
+  size_t head_;
+  size_t size_;
+};
+
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__RING_BUFFER_HPP_
@@ -0,0 +1,334 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__SHARED_EVENT_BUFFER_HPP_
+#define MESSAGE_FILTERS__SHARED_EVENT_BUFFER_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "message_filters/connection.hpp"
+#include "message_filters/message_event.hpp"
+#include "message_filters/message_traits.hpp"
+#include "message_filters/ring_buffer.hpp"
+#include "message_filters/simple_filter.hpp"
+
+namespace message_filters
+{
+
+/**
+ * \brief Buffers the messages of one topic once for several readers.
+ *
+ * Each reader, typically a synchronization policy, reads the buffer through its own Cursor,
+ * which starts past the newest message when it is created, so that it only sees the messages
+ * added from then on, and moves forward independently of the others. The timestamp of each
+ * message is read once when the message is added. A message is kept until every cursor has moved
+ * past it, or until more than \p capacity messages are buffered, whichever comes first; a cursor
+ * behind the messages discarded for capacity resumes at the oldest message left. The buffer is
+ * owned by its users through std::shared_ptr, and each cursor keeps it alive.
+ *
+ * Messages are expected in nondecreasing timestamp order, as a single topic delivers them. A
+ * message older than the newest one buffered is not buffered.
+ *
+ * SharedEventBuffer immediately passes messages through to its output connections, after they
+ * have been buffered.
+ *
+ * \section connections CONNECTIONS
+ *
+ * SharedEventBuffer's input and output connections are both of the same signature as rclcpp
+ * subscription callbacks, ie.
+\verbatim
+void callback(const std::shared_ptr<M const> &);
+\endverbatim
+ */
+template<class M>
+class SharedEventBuffer : public SimpleFilter<M>
+{
+public:
+  typedef std::shared_ptr<M const> MConstPtr;
+  typedef MessageEvent<M const> EventType;
+
+  /**
+   * \brief Independent read position in a SharedEventBuffer.
+   *
+   * The cursor sees the buffered messages from its position to the newest one. A cursor attached
+   * to a buffer starts empty, and a copy of a cursor starts at the same position. Its accessors
+   * assume that the buffer is locked through lock(), so that a sequence of reads sees a
+   * consistent buffer while other threads add messages. A default constructed cursor is not
+   * attached to any buffer.
+   */
+  class Cursor
+  {
+public:
+    Cursor()
+    : position_(0)
+    {
+    }
+
+    explicit Cursor(const std::shared_ptr<SharedEventBuffer> & buffer)
+    : position_(0)
+    {
+      attach(buffer, nullptr);
+    }
+
+    // The copy is placed at the same position
+    Cursor(const Cursor & other)
+    : position_(0)
+    {
+      *this = other;
+    }
+
+    Cursor & operator=(const Cursor & rhs)
+    {
+      if (this != &rhs) {
+        detach();
+        attach(rhs.buffer_, &rhs);
+      }
+      return *this;
+    }
+
+    ~Cursor()
+    {
+      detach();
+    }
+
+    bool attached() const
+    {
+      return static_cast<bool>(buffer_);
+    }
+
+    std::unique_lock<std::mutex> lock() const
+    {
+      assert(buffer_);
+      return std::unique_lock<std::mutex>(buffer_->mutex_);
+    }
+
+    // The number of messages from the cursor to the newest one
+    size_t size() const
+    {
+      return buffer_->endSequence() - begin();
+    }
+
+    // The timestamp, in nanoseconds, of the n-th message from the cursor
+    int64_t stamp(size_t n) const
+    {
+      return entry(n).stamp;
+    }
+
+    const EventType & event(size_t n) const
+    {
+      return entry(n).event;
+    }
+
+    // Moves past the message at the cursor, assumes size() > 0
+    void pop_front()
+    {
+      assert(size() > 0);
+      position_ = begin() + 1;
+      buffer_->trim();
+    }
+
+private:
+    friend class SharedEventBuffer;
+
+    void attach(const std::shared_ptr<SharedEventBuffer> & buffer, const Cursor * at)
+    {
+      buffer_ = buffer;
+      if (buffer_) {
+        std::lock_guard<std::mutex> lock(buffer_->mutex_);
+        position_ = at ? at->begin() : buffer_->endSequence();
+        buffer_->cursors_.push_back(this);
+      }
+    }
+
+    void detach()
+    {
+      if (buffer_) {
+        std::lock_guard<std::mutex> lock(buffer_->mutex_);
+        auto & cursors = buffer_->cursors_;
+        cursors.erase(std::find(cursors.begin(), cursors.end(), this));
+        buffer_->trim();
+      }
+      buffer_.reset();
+    }
+
+    // The sequence number of the first message the cursor sees
+    uint64_t begin() const
+    {
+      return std::max(position_, buffer_->first_sequence_);
+    }
+
+    const typename SharedEventBuffer::Entry & entry(size_t n) const
+    {
+      assert(n < size());
+      return buffer_->entries_[begin() - buffer_->first_sequence_ + n];
+    }
+
+    std::shared_ptr<SharedEventBuffer> buffer_;
+    uint64_t position_;  // Sequence number, protected by the buffer's mutex
+  };
+
+  /**
+   * \brief Constructor
+   *
+   * \param f The filter to connect the input to
+   * \param capacity The maximum number of messages kept, 0 for unbounded
+   */
+  template<class F>
+  SharedEventBuffer(F & f, uint32_t capacity)
+  : SharedEventBuffer(capacity)
+  {
+    connectInput(f);
+  }
+
+  /**
+   * \brief Constructor
+   *
+   * \param capacity The maximum number of messages kept, 0 for unbounded
+   */
+  explicit SharedEventBuffer(uint32_t capacity)
+  : capacity_(capacity)
+    , first_sequence_(0)
+    , newest_stamp_(std::numeric_limits<int64_t>::min())
+    , out_of_order_count_(0)
+  {
+  }
+
+  template<class F>
+  void connectInput(F & f)
+  {
+    incoming_connection_.disconnect();
+    incoming_connection_ = f.registerCallback(
+      typename SimpleFilter<M>::EventCallback(
+        std::bind(&SharedEventBuffer::add, this, std::placeholders::_1)));
+  }
+
+  ~SharedEventBuffer()
+  {
+    incoming_connection_.disconnect();
+  }
+
+  void add(const EventType & evt)
+  {
+    namespace mt = message_filters::message_traits;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      int64_t stamp = mt::TimeStamp<M>::value(*evt.getMessage()).nanoseconds();
+      if (stamp < newest_stamp_) {
+        ++out_of_order_count_;
+        // Still passed through below
+      } else if (!cursors_.empty()) {
+        newest_stamp_ = stamp;
+        entries_.push_back(Entry{stamp, evt});
+        if (capacity_ > 0 && entries_.size() > capacity_) {
+          entries_.pop_front();
+          ++first_sequence_;
+        }
+      } else {
+        // Nobody would ever read it
+        newest_stamp_ = stamp;
+        ++first_sequence_;
+      }
+    }
+
+    this->signalMessage(evt);
+  }
+
+  void add(const MConstPtr & msg)
+  {
+    add(EventType(msg));
+  }
+
+  /**
+   * \brief The number of messages currently buffered.
+   */
+  size_t size()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+  /**
+   * \brief The number of messages not buffered because they were older than the newest one.
+   */
+  uint64_t getOutOfOrderCount()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return out_of_order_count_;
+  }
+
+private:
+  struct Entry
+  {
+    int64_t stamp;  // Nanoseconds
+    EventType event;
+  };
+
+  // assumes mutex_ is already locked
+  uint64_t endSequence() const
+  {
+    return first_sequence_ + entries_.size();
+  }
+
+  // Discards the messages every cursor has moved past
+  // assumes mutex_ is already locked
+  void trim()
+  {
+    uint64_t oldest = endSequence();
+    for (const Cursor * cursor : cursors_) {
+      oldest = std::min(oldest, cursor->begin());
+    }
+    while (first_sequence_ < oldest) {
+      entries_.pop_front();
+      ++first_sequence_;
+    }
+  }
+
+  uint32_t capacity_;
+  Connection incoming_connection_;
+
+  // Everything below is protected by mutex_
+  std::mutex mutex_;
+  RingBuffer<Entry> entries_;
+  uint64_t first_sequence_;  // Sequence number of entries_.front()
+  std::vector<const Cursor *> cursors_;
+  int64_t newest_stamp_;
+  uint64_t out_of_order_count_;
+};
+
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__SHARED_EVENT_BUFFER_HPP_
@@ -0,0 +1,322 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__SYNC_GROUP_HPP_
+#define MESSAGE_FILTERS__SYNC_GROUP_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "message_filters/connection.hpp"
+
+namespace message_filters
+{
+
+/**
+ * \brief A fixed pool of worker threads and a single timer wheel, shared by many filters.
+ *
+ * Filters join the group and get a member id. The work they post, and the timer callbacks they
+ * add, then run on the worker the member was assigned to. Members are spread over the workers
+ * round-robin, and the work of one member always runs on the same worker, in the order it was
+ * posted, so a member never runs concurrently with itself and its own lock is not contended.
+ *
+ * All the timers of the group are driven by one thread advancing a hashed timer wheel by one
+ * slot per tick, so adding, firing and cancelling a timer costs O(1) however many there are. A
+ * timer fires no earlier than its period, rounded up to a whole number of ticks, and no more
+ * than once at a time: it is skipped while its previous callback is still waiting for its worker.
+ *
+ * The number of threads is therefore fixed by the group, not by how many filters use it.
+ */
+class SyncGroup : public noncopyable
+{
+public:
+  typedef uint64_t MemberId;
+
+  /**
+   * \param thread_count The number of worker threads, 0 for one per hardware thread.
+   * \param tick The resolution of the timer wheel.
+   */
+  explicit SyncGroup(
+    size_t thread_count = 0,
+    std::chrono::nanoseconds tick = std::chrono::milliseconds(1))
+  : tick_(std::max(tick, std::chrono::nanoseconds(1)))
+    , wheel_(WHEEL_SIZE)
+  {
+    if (thread_count == 0) {
+      thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t k = 0; k < thread_count; ++k) {
+      workers_.push_back(std::make_unique<Worker>());
+    }
+    for (auto & worker : workers_) {
+      worker->thread = std::thread(&SyncGroup::runWorker, this, worker.get());
+    }
+    timer_thread_ = std::thread(&SyncGroup::runTimers, this);
+  }
+
+  /**
+   * \brief Stop the threads. Work that has not started yet is discarded.
+   */
+  ~SyncGroup()
+  {
+    {
+      std::lock_guard<std::mutex> lock(timer_mutex_);
+      stopping_ = true;
+    }
+    timer_cond_.notify_one();
+    timer_thread_.join();
+
+    for (auto & worker : workers_) {
+      {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->stopping = true;
+      }
+      worker->cond.notify_one();
+    }
+    for (auto & worker : workers_) {
+      worker->thread.join();
+    }
+  }
+
+  size_t getThreadCount() const
+  {
+    return workers_.size();
+  }
+
+  /**
+   * \brief Add a member to the group, assigning it to the next worker.
+   */
+  MemberId join()
+  {
+    std::lock_guard<std::mutex> lock(timer_mutex_);
+    return next_member_++;
+  }
+
+  /**
+   * \brief Remove a member from the group.
+   *
+   * Its timers are cancelled and the work it posted that has not started yet is discarded. If its
+   * worker is running some of its work, this waits for it to return, unless called from that
+   * work. Once this returns, nothing of the member runs anymore, so the member can be destroyed.
+   * It must not post any more work.
+   */
+  void leave(MemberId member)
+  {
+    {
+      std::lock_guard<std::mutex> lock(timer_mutex_);
+      for (auto it = timers_.begin(); it != timers_.end(); ) {
+        if (it->second.member == member) {
+          it = timers_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+
+    Worker & worker = workerOf(member);
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    worker.tasks.erase(
+      std::remove_if(
+        worker.tasks.begin(), worker.tasks.end(),
+        [member](const Task & task) {return task.member == member;}),
+      worker.tasks.end());
+    if (std::this_thread::get_id() != worker.thread.get_id()) {
+      worker.idle.wait(lock, [&worker, member]() {return worker.running != member;});
+    }
+  }
+
+  /**
+   * \brief Run \p work on the worker of \p member, after the work it posted before.
+   */
+  void post(MemberId member, std::function<void()> work)
+  {
+    Worker & worker = workerOf(member);
+    {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      worker.tasks.push_back(Task{member, std::move(work)});
+    }
+    worker.cond.notify_one();
+  }
+
+  /**
+   * \brief Run \p callback on the worker of \p member every \p period, until the member leaves.
+   */
+  void addTimer(MemberId member, std::chrono::nanoseconds period, std::function<void()> callback)
+  {
+    Timer timer;
+    timer.member = member;
+    timer.period_ticks = (std::max<int64_t>(period.count(), 1) + tick_.count() - 1) / tick_.count();
+    timer.state = std::make_shared<TimerState>();
+    timer.state->callback = std::move(callback);
+
+    std::lock_guard<std::mutex> lock(timer_mutex_);
+    uint64_t id = next_timer_++;
+    schedule(id, timer);
+    timers_.emplace(id, std::move(timer));
+  }
+
+private:
+  // A power of two, so that the slot of a tick is found with a mask
+  static const size_t WHEEL_SIZE = 256;
+
+  struct Task
+  {
+    MemberId member;
+    std::function<void()> work;
+  };
+
+  struct Worker
+  {
+    std::mutex mutex;
+    std::condition_variable cond;  // Signaled when a task is posted or the group stops
+    std::condition_variable idle;  // Signaled when the worker is done with a task
+    std::deque<Task> tasks;
+    MemberId running{0};  // The member whose task is running, 0 if none
+    bool stopping{false};
+    std::thread thread;
+  };
+
+  // Shared with the work posted when the timer fires
+  struct TimerState
+  {
+    std::function<void()> callback;
+    std::atomic<bool> queued{false};  // Set while the callback waits for its worker
+  };
+
+  struct Timer
+  {
+    MemberId member;
+    uint64_t period_ticks;
+    uint64_t rounds;  // Full turns of the wheel left before the timer fires
+    std::shared_ptr<TimerState> state;
+  };
+
+  Worker & workerOf(MemberId member)
+  {
+    return *workers_[member % workers_.size()];
+  }
+
+  void runWorker(Worker * worker)
+  {
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    while (true) {
+      worker->cond.wait(lock, [worker]() {return worker->stopping || !worker->tasks.empty();});
+      if (worker->stopping) {
+        return;
+      }
+      Task task = std::move(worker->tasks.front());
+      worker->tasks.pop_front();
+      worker->running = task.member;
+      lock.unlock();
+      task.work();
+      // Release what the task holds before a waiting leave() can return
+      task.work = nullptr;
+      lock.lock();
+      worker->running = 0;
+      worker->idle.notify_all();
+    }
+  }
+
+  void runTimers()
+  {
+    auto next_tick = std::chrono::steady_clock::now() + tick_;
+    std::unique_lock<std::mutex> lock(timer_mutex_);
+    while (!timer_cond_.wait_until(lock, next_tick, [this]() {return stopping_;})) {
+      next_tick += tick_;
+      cursor_ = (cursor_ + 1) & (WHEEL_SIZE - 1);
+      std::vector<uint64_t> due;
+      due.swap(wheel_[cursor_]);
+      for (uint64_t id : due) {
+        auto it = timers_.find(id);
+        if (it == timers_.end()) {
+          // Cancelled
+          continue;
+        }
+        Timer & timer = it->second;
+        if (timer.rounds > 0) {
+          --timer.rounds;
+          wheel_[cursor_].push_back(id);
+          continue;
+        }
+        fire(timer);
+        schedule(id, timer);
+      }
+    }
+  }
+
+  // assumes timer_mutex_ is already locked
+  void fire(const Timer & timer)
+  {
+    if (timer.state->queued.exchange(true)) {
+      return;
+    }
+    std::shared_ptr<TimerState> state = timer.state;
+    post(
+      timer.member, [state]() {
+        state->queued.store(false);
+        state->callback();
+      });
+  }
+
+  // assumes timer_mutex_ is already locked
+  void schedule(uint64_t id, Timer & timer)
+  {
+    timer.rounds = (timer.period_ticks - 1) / WHEEL_SIZE;
+    wheel_[(cursor_ + timer.period_ticks) & (WHEEL_SIZE - 1)].push_back(id);
+  }
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  std::chrono::nanoseconds tick_;
+  // Ids of the timers due in each slot, including cancelled ones, which are skipped
+  std::vector<std::vector<uint64_t>> wheel_;
+  size_t cursor_{0};  // The slot of the current tick
+  std::unordered_map<uint64_t, Timer> timers_;
+  uint64_t next_timer_{1};
+  MemberId next_member_{1};
+  bool stopping_{false};
+  std::mutex timer_mutex_;  // Protects the timers, the wheel and the member ids
+  std::condition_variable timer_cond_;
+  std::thread timer_thread_;
+};
+
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__SYNC_GROUP_HPP_
@@ -29,10 +29,11 @@
 #ifndef MESSAGE_FILTERS__SYNC_POLICIES__APPROXIMATE_EPSILON_TIME_HPP_
 #define MESSAGE_FILTERS__SYNC_POLICIES__APPROXIMATE_EPSILON_TIME_HPP_
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
-#include <deque>
 #include <limits>
+#include <memory_resource>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -43,6 +44,8 @@
 #include "message_filters/connection.hpp"
 #include "message_filters/message_traits.hpp"
 #include "message_filters/null_types.hpp"
+#include "message_filters/queue_size_tuner.hpp"
+#include "message_filters/ring_buffer.hpp"
 #include "message_filters/signal9.hpp"
 #include "message_filters/synchronizer.hpp"
 
@@ -74,15 +77,31 @@ public:
   typedef typename Super::M8Event M8Event;
   typedef Events Tuple;
 
-  ApproximateEpsilonTime(uint32_t queue_size, rclcpp::Duration epsilon)
+  /**
+   * \param queue_size The maximum number of messages kept per input.
+   * \param epsilon The maximum stamp difference between the messages of a tuple.
+   * \param upstream The memory resource the internal queues draw from. Memory released by the
+   *        queues is pooled and reused, so once the queues have reached their working size
+   *        no further requests are made to \p upstream.
+   */
+  ApproximateEpsilonTime(
+    uint32_t queue_size, rclcpp::Duration epsilon,
+    std::pmr::memory_resource * upstream = std::pmr::get_default_resource())
   : parent_(nullptr)
     , queue_size_(queue_size)
+    , queue_sizes_{}
     , epsilon_{epsilon}
+    , memory_pool_(upstream)
+    , events_(std::allocator_arg, std::pmr::polymorphic_allocator<std::byte>(&memory_pool_))
+    , buckets_(&memory_pool_)
   {
   }
 
   ApproximateEpsilonTime(const ApproximateEpsilonTime & e)
   : epsilon_{e.epsilon_}
+    , memory_pool_(e.memory_pool_.upstream_resource())
+    , events_(std::allocator_arg, std::pmr::polymorphic_allocator<std::byte>(&memory_pool_))
+    , buckets_(&memory_pool_)
   {
     *this = e;
   }
@@ -91,8 +110,15 @@ public:
   {
     parent_ = rhs.parent_;
     queue_size_ = rhs.queue_size_;
+    queue_sizes_ = rhs.queue_sizes_;
     events_ = rhs.events_;
+    number_of_non_empty_events_ = rhs.number_of_non_empty_events_;
     epsilon_ = rhs.epsilon_;
+    time_buckets_ = rhs.time_buckets_;
+    oldest_bucket_ = rhs.oldest_bucket_;
+    buckets_ = rhs.buckets_;
+    queue_size_tuner_ = rhs.queue_size_tuner_;
+    adaptive_queue_size_ = rhs.adaptive_queue_size_;
 
     return *this;
   }
@@ -107,21 +133,159 @@ public:
   {
     assert(parent_);
 
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (time_buckets_) {
+      add_to_bucket<i>(evt);
+    } else {
+      add_to_queue<i>(evt);
+    }
+    lock.unlock();
+
+    // Deliver the matched tuples, if any, now that other inputs can be added again
+    parent_->dispatchSignals();
+  }
+
+  /**
+   * \brief Match messages by time bucket rather than by oldest queued message.
+   *
+   * The time line is cut into buckets of width epsilon, and every message goes into the bucket
+   * its stamp falls in. A tuple is published as soon as a bucket holds a message of every input,
+   * and that bucket and all older ones are then closed. Adding a message therefore costs the same
+   * however many messages are pending, but messages that are within epsilon of each other and
+   * fall on both sides of a bucket boundary are not matched.
+   *
+   * Only the queue_size most recent buckets are kept open. Messages for a closed bucket are
+   * dropped, and so are the messages of an input that already has one in their bucket.
+   *
+   * Must be called before any message is added.
+   */
+  void set_time_buckets(bool enabled)
+  {
     std::lock_guard<std::mutex> lock(mutex_);
+    assert(number_of_non_empty_events_ == 0);
+    assert(!enabled || (queue_size_ > 0 && epsilon_ > rclcpp::Duration(0, 0)));
+    time_buckets_ = enabled;
+    buckets_.assign(enabled ? queue_size_ : 0, Bucket());
+  }
 
+  /**
+   * \brief Size the queues from the observed rates and lags of the inputs.
+   *
+   * Once every input has received a few messages, the queue size of each input follows the
+   * estimate of a QueueSizeTuner, within [\p min_size, \p max_size]. The sizes in use can be read
+   * back with get_queue_size(), and the estimates they come from with get_queue_size_tuner().
+   * Has no effect on the number of buckets kept by set_time_buckets().
+   */
+  void enable_adaptive_queue_size(uint32_t min_size, uint32_t max_size)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_size_tuner_ = QueueSizeTuner(RealTypeCount::value, min_size, max_size);
+    adaptive_queue_size_ = true;
+  }
+
+  /**
+   * \brief Override the maximum number of messages kept for input \p i, for instance with a
+   * size settled by enable_adaptive_queue_size() in an earlier run.
+   */
+  void set_queue_size(size_t i, uint32_t queue_size)
+  {
+    assert(i < queue_sizes_.size() && queue_size > 0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_sizes_[i] = queue_size;
+  }
+
+  /**
+   * \brief The maximum number of messages currently kept for input \p i.
+   */
+  uint32_t get_queue_size(size_t i)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_size_for(i);
+  }
+
+  QueueSizeTuner get_queue_size_tuner()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_size_tuner_;
+  }
+
+private:
+  // assumes mutex_ is already locked
+  uint32_t queue_size_for(size_t i) const
+  {
+    if (adaptive_queue_size_ && queue_size_tuner_.ready()) {
+      return queue_size_tuner_.queueSize(i);
+    }
+    return queue_sizes_[i] > 0 ? queue_sizes_[i] : queue_size_;
+  }
+
+  // assumes mutex_ is already locked
+  template<size_t i>
+  void add_to_queue(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    namespace mt = message_filters::message_traits;
+    using ThisEventType = typename std::tuple_element<i, Events>::type;
+    if (adaptive_queue_size_) {
+      queue_size_tuner_.observe(
+        i, mt::TimeStamp<typename ThisEventType::Message>::value(*evt.getMessage()).nanoseconds());
+    }
     auto & events_of_this_type = std::get<i>(events_);
-    if (0u == events_of_this_type.size()) {
+    if (events_of_this_type.empty()) {
       ++number_of_non_empty_events_;
     }
     events_of_this_type.push_back(evt);
     if (number_of_non_empty_events_ == RealTypeCount::value) {
       process();
-    } else if (events_of_this_type.size() > queue_size_) {
-      erase_beginning_of_vector<i>();
+    } else {
+      // The size may have just been lowered by the tuner
+      while (events_of_this_type.size() > queue_size_for(i)) {
+        erase_beginning_of_vector<i>();
+      }
     }
   }
 
-private:
+  // assumes mutex_ is already locked
+  template<size_t i>
+  void add_to_bucket(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    namespace mt = message_filters::message_traits;
+    using ThisEventType = typename std::tuple_element<i, Events>::type;
+    const int64_t index = mt::TimeStamp<typename ThisEventType::Message>::value(
+      *evt.getMessage()).nanoseconds() / epsilon_.nanoseconds();
+    if (index < oldest_bucket_) {
+      return;
+    }
+    if (index - oldest_bucket_ >= static_cast<int64_t>(buckets_.size())) {
+      // Close the buckets that no longer fit. Their slots are cleared lazily, when reused.
+      oldest_bucket_ = index - static_cast<int64_t>(buckets_.size()) + 1;
+    }
+
+    Bucket & bucket = buckets_[index % buckets_.size()];
+    if (bucket.index != index) {
+      bucket.index = index;
+      bucket.count = 0;
+      bucket.events = Tuple();
+    }
+    auto & slot = std::get<i>(bucket.events);
+    if (slot.getMessage()) {
+      return;
+    }
+    slot = evt;
+    if (++bucket.count < RealTypeCount::value) {
+      return;
+    }
+
+    const Tuple & t = bucket.events;
+    parent_->enqueueSignal(
+      std::get<0>(t), std::get<1>(t), std::get<2>(t),
+      std::get<3>(t), std::get<4>(t), std::get<5>(t),
+      std::get<6>(t), std::get<7>(t), std::get<8>(t));
+    bucket.index = -1;
+    bucket.events = Tuple();
+    oldest_bucket_ = index + 1;
+  }
+
   using TimeIndexPair = std::pair<rclcpp::Time, size_t>;
 
   template<size_t Is>
@@ -134,12 +298,12 @@ private:
       return current;
     }
     const auto & events_of_this_type = std::get<Is>(events_);
-    if (0u == events_of_this_type.size()) {
+    if (events_of_this_type.empty()) {
       // this condition should not happen
       return current;
     }
     auto candidate = mt::TimeStamp<typename ThisEventType::Message>::value(
-      *events_of_this_type.at(0).getMessage());
+      *events_of_this_type.front().getMessage());
     if (current.first > candidate) {
       return std::make_pair(candidate, Is);
     }
@@ -176,12 +340,12 @@ private:
       return true;
     }
     const auto & events_of_this_type = std::get<Is>(events_);
-    if (0u == events_of_this_type.size()) {
+    if (events_of_this_type.empty()) {
       // this condition should not happen
       return false;
     }
     auto ts = mt::TimeStamp<typename ThisEventType::Message>::value(
-      *events_of_this_type.at(0).getMessage());
+      *events_of_this_type.front().getMessage());
     if (older.first + epsilon_ >= ts) {
       return true;
     }
@@ -213,8 +377,8 @@ private:
       return;
     }
     auto & this_vector = std::get<Is>(events_);
-    if (this_vector.begin() != this_vector.end()) {
-      this_vector.erase(this_vector.begin());
+    if (!this_vector.empty()) {
+      this_vector.pop_front();
       if (this_vector.empty()) {
         --number_of_non_empty_events_;
       }
@@ -243,15 +407,15 @@ private:
       return;
     }
     auto & this_vector = std::get<Is>(events_);
-    if (this_vector.begin() == this_vector.end()) {
+    if (this_vector.empty()) {
       return;
     }
     auto event_ts = mt::TimeStamp<typename ThisEventType::Message>::value(
-      *this_vector.at(0).getMessage());
+      *this_vector.front().getMessage());
     if (timestamp + epsilon_ < event_ts) {
       return;
     }
-    this_vector.erase(this_vector.begin());
+    this_vector.pop_front();
     if (this_vector.empty()) {
       --number_of_non_empty_events_;
     }
@@ -270,48 +434,49 @@ private:
     return erase_old_events_if_on_sync_with_ts_helper(timestamp, std::make_index_sequence<9u>());
   }
 
+  // assumes mutex_ is already locked, the tuple is delivered once it is released
   void signal()
   {
     if constexpr (RealTypeCount::value == 2) {
-      parent_->signal(
-        std::get<0>(events_).at(0), std::get<1>(events_).at(0),
+      parent_->enqueueSignal(
+        std::get<0>(events_).front(), std::get<1>(events_).front(),
         M2Event{}, M3Event{}, M4Event{}, M5Event{}, M6Event{}, M7Event{}, M8Event{});
     } else if constexpr (RealTypeCount::value == 3) {
-      parent_->signal(
-        std::get<0>(events_).at(0), std::get<1>(events_).at(0), std::get<2>(events_).at(0),
+      parent_->enqueueSignal(
+        std::get<0>(events_).front(), std::get<1>(events_).front(), std::get<2>(events_).front(),
         M3Event{}, M4Event{}, M5Event{}, M6Event{}, M7Event{}, M8Event{});
     } else if constexpr (RealTypeCount::value == 4) {
-      parent_->signal(
-        std::get<0>(events_).at(0), std::get<1>(events_).at(0), std::get<2>(events_).at(0),
-        std::get<3>(events_).at(0),
+      parent_->enqueueSignal(
+        std::get<0>(events_).front(), std::get<1>(events_).front(), std::get<2>(events_).front(),
+        std::get<3>(events_).front(),
         M4Event{}, M5Event{}, M6Event{}, M7Event{}, M8Event{});
     } else if constexpr (RealTypeCount::value == 5) {
-      parent_->signal(
-        std::get<0>(events_).at(0), std::get<1>(events_).at(0), std::get<2>(events_).at(0),
-        std::get<3>(events_).at(0), std::get<4>(events_).at(0),
+      parent_->enqueueSignal(
+        std::get<0>(events_).front(), std::get<1>(events_).front(), std::get<2>(events_).front(),
+        std::get<3>(events_).front(), std::get<4>(events_).front(),
         M5Event{}, M6Event{}, M7Event{}, M8Event{});
     } else if constexpr (RealTypeCount::value == 6) {
-      parent_->signal(
-        std::get<0>(events_).at(0), std::get<1>(events_).at(0), std::get<2>(events_).at(0),
-        std::get<3>(events_).at(0), std::get<4>(events_).at(0), std::get<5>(events_).at(0),
+      parent_->enqueueSignal(
+        std::get<0>(events_).front(), std::get<1>(events_).front(), std::get<2>(events_).front(),
+        std::get<3>(events_).front(), std::get<4>(events_).front(), std::get<5>(events_).front(),
         M6Event{}, M7Event{}, M8Event{});
     } else if constexpr (RealTypeCount::value == 7) {
-      parent_->signal(
-        std::get<0>(events_).at(0), std::get<1>(events_).at(0), std::get<2>(events_).at(0),
-        std::get<3>(events_).at(0), std::get<4>(events_).at(0), std::get<5>(events_).at(0),
-        std::get<6>(events_).at(0),
+      parent_->enqueueSignal(
+        std::get<0>(events_).front(), std::get<1>(events_).front(), std::get<2>(events_).front(),
+        std::get<3>(events_).front(), std::get<4>(events_).front(), std::get<5>(events_).front(),
+        std::get<6>(events_).front(),
         M7Event{}, M8Event{});
     } else if constexpr (RealTypeCount::value == 8) {
-      parent_->signal(
-        std::get<0>(events_).at(0), std::get<1>(events_).at(0), std::get<2>(events_).at(0),
-        std::get<3>(events_).at(0), std::get<4>(events_).at(0), std::get<5>(events_).at(0),
-        std::get<6>(events_).at(0), std::get<7>(events_).at(0),
+      parent_->enqueueSignal(
+        std::get<0>(events_).front(), std::get<1>(events_).front(), std::get<2>(events_).front(),
+        std::get<3>(events_).front(), std::get<4>(events_).front(), std::get<5>(events_).front(),
+        std::get<6>(events_).front(), std::get<7>(events_).front(),
         M8Event{});
     } else if constexpr (RealTypeCount::value == 9) {
-      parent_->signal(
-        std::get<0>(events_).at(0), std::get<1>(events_).at(0), std::get<2>(events_).at(0),
-        std::get<3>(events_).at(0), std::get<4>(events_).at(0), std::get<5>(events_).at(0),
-        std::get<6>(events_).at(0), std::get<7>(events_).at(0), std::get<8>(events_).at(0));
+      parent_->enqueueSignal(
+        std::get<0>(events_).front(), std::get<1>(events_).front(), std::get<2>(events_).front(),
+        std::get<3>(events_).front(), std::get<4>(events_).front(), std::get<5>(events_).front(),
+        std::get<6>(events_).front(), std::get<7>(events_).front(), std::get<8>(events_).front());
     } else {
       static_assert("RealTypeCount::value should be >=2 and <=9");
     }
@@ -334,14 +499,31 @@ private:
   Sync * parent_;
 
   uint32_t queue_size_;
+  std::array<uint32_t, 9> queue_sizes_;  // Set by set_queue_size(), 0 for queue_size_
   rclcpp::Duration epsilon_;
   size_t number_of_non_empty_events_{0};
+  // Recycles the memory of events_, protected by mutex_
+  std::pmr::unsynchronized_pool_resource memory_pool_;
+  // One FIFO per input, so that consuming the oldest event does not move the others
   using TupleOfVecOfEvents = std::tuple<
-    std::vector<M0Event>, std::vector<M1Event>, std::vector<M2Event>,
-    std::vector<M3Event>, std::vector<M4Event>, std::vector<M5Event>,
-    std::vector<M6Event>, std::vector<M7Event>, std::vector<M8Event>>;
+    RingBuffer<M0Event>, RingBuffer<M1Event>, RingBuffer<M2Event>,
+    RingBuffer<M3Event>, RingBuffer<M4Event>, RingBuffer<M5Event>,
+    RingBuffer<M6Event>, RingBuffer<M7Event>, RingBuffer<M8Event>>;
   TupleOfVecOfEvents events_;
 
+  struct Bucket
+  {
+    int64_t index{-1};  // Stamp divided by epsilon, -1 for an unused slot
+    size_t count{0};  // Number of inputs with a message in the bucket
+    Tuple events;
+  };
+  bool time_buckets_{false};
+  int64_t oldest_bucket_{0};  // Index of the oldest open bucket
+  std::pmr::vector<Bucket> buckets_;  // Ring of open buckets, by index modulo its size
+
+  QueueSizeTuner queue_size_tuner_;
+  bool adaptive_queue_size_{false};  // Whether the queue sizes follow queue_size_tuner_
+
   std::mutex mutex_;
 };
 
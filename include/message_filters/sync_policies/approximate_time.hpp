@@ -33,9 +33,13 @@
 
 #include <rcutils/logging_macros.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstddef>
 #include <deque>
 #include <limits>
+#include <memory_resource>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -45,6 +49,7 @@
 #include "message_filters/connection.hpp"
 #include "message_filters/message_traits.hpp"
 #include "message_filters/null_types.hpp"
+#include "message_filters/queue_size_tuner.hpp"
 #include "message_filters/signal9.hpp"
 #include "message_filters/synchronizer.hpp"
 
@@ -73,48 +78,87 @@ struct ApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
   typedef typename Super::M6Event M6Event;
   typedef typename Super::M7Event M7Event;
   typedef typename Super::M8Event M8Event;
-  typedef std::deque<M0Event> M0Deque;
-  typedef std::deque<M1Event> M1Deque;
-  typedef std::deque<M2Event> M2Deque;
-  typedef std::deque<M3Event> M3Deque;
-  typedef std::deque<M4Event> M4Deque;
-  typedef std::deque<M5Event> M5Deque;
-  typedef std::deque<M6Event> M6Deque;
-  typedef std::deque<M7Event> M7Deque;
-  typedef std::deque<M8Event> M8Deque;
-  typedef std::vector<M0Event> M0Vector;
-  typedef std::vector<M1Event> M1Vector;
-  typedef std::vector<M2Event> M2Vector;
-  typedef std::vector<M3Event> M3Vector;
-  typedef std::vector<M4Event> M4Vector;
-  typedef std::vector<M5Event> M5Vector;
-  typedef std::vector<M6Event> M6Vector;
-  typedef std::vector<M7Event> M7Vector;
-  typedef std::vector<M8Event> M8Vector;
+  typedef std::pmr::deque<M0Event> M0Deque;
+  typedef std::pmr::deque<M1Event> M1Deque;
+  typedef std::pmr::deque<M2Event> M2Deque;
+  typedef std::pmr::deque<M3Event> M3Deque;
+  typedef std::pmr::deque<M4Event> M4Deque;
+  typedef std::pmr::deque<M5Event> M5Deque;
+  typedef std::pmr::deque<M6Event> M6Deque;
+  typedef std::pmr::deque<M7Event> M7Deque;
+  typedef std::pmr::deque<M8Event> M8Deque;
+  typedef std::pmr::vector<M0Event> M0Vector;
+  typedef std::pmr::vector<M1Event> M1Vector;
+  typedef std::pmr::vector<M2Event> M2Vector;
+  typedef std::pmr::vector<M3Event> M3Vector;
+  typedef std::pmr::vector<M4Event> M4Vector;
+  typedef std::pmr::vector<M5Event> M5Vector;
+  typedef std::pmr::vector<M6Event> M6Vector;
+  typedef std::pmr::vector<M7Event> M7Vector;
+  typedef std::pmr::vector<M8Event> M8Vector;
   typedef Events Tuple;
   typedef std::tuple<M0Deque, M1Deque, M2Deque, M3Deque, M4Deque, M5Deque, M6Deque, M7Deque,
       M8Deque> DequeTuple;
   typedef std::tuple<M0Vector, M1Vector, M2Vector, M3Vector, M4Vector, M5Vector, M6Vector, M7Vector,
       M8Vector> VectorTuple;
 
-  ApproximateTime(uint32_t queue_size)  // NOLINT(runtime/explicit)
+  /**
+   * \param queue_size The maximum number of messages kept per input. It can be overridden for
+   *        individual inputs with setQueueSize() and setQueueSpan().
+   * \param upstream The memory resource the internal queues draw from. Memory released by the
+   *        queues is pooled and reused, so once the queues have reached their working size
+   *        no further requests are made to \p upstream.
+   */
+  ApproximateTime(  // NOLINT(runtime/explicit)
+    uint32_t queue_size,
+    std::pmr::memory_resource * upstream = std::pmr::get_default_resource())
   : parent_(0)
-    , queue_size_(queue_size)
+    , queue_sizes_(9, queue_size)
+    , queue_spans_(9, std::numeric_limits<int64_t>::max())
+    , memory_pool_(upstream)
+    , deques_(std::allocator_arg, std::pmr::polymorphic_allocator<std::byte>(&memory_pool_))
     , num_non_empty_deques_(0)
+    , past_(std::allocator_arg, std::pmr::polymorphic_allocator<std::byte>(&memory_pool_))
     , pivot_(NO_PIVOT)
     , max_interval_duration_(rclcpp::Duration(std::numeric_limits<int32_t>::max(), 999999999))
     , age_penalty_(0.1)
     , has_dropped_messages_(9, false)
     , inter_message_lower_bounds_(9, rclcpp::Duration(0, 0))
     , warned_about_incorrect_bound_(9, false)
+    , deadline_(rclcpp::Duration(0, 0))
+    , has_deadline_(false)
+    , num_deadline_publishes_(0)
   {
     // The synchronizer will tend to drop many messages with a queue size of 1.
     // At least 2 is recommended.
-    assert(queue_size_ > 0);
+    assert(queue_size > 0);
+  }
+
+  /**
+   * \param queue_sizes The maximum number of messages kept for each input, one entry per input.
+   *        Inputs with very different rates can then each keep a queue spanning about the same
+   *        time, instead of the slow inputs being sized for the fastest one.
+   * \param upstream The memory resource the internal queues draw from.
+   */
+  explicit ApproximateTime(
+    const std::vector<uint32_t> & queue_sizes,
+    std::pmr::memory_resource * upstream = std::pmr::get_default_resource())
+  : ApproximateTime(
+      queue_sizes.empty() ? 1 : *std::max_element(queue_sizes.begin(), queue_sizes.end()),
+      upstream)
+  {
+    assert(queue_sizes.size() == static_cast<size_t>(RealTypeCount::value));
+    for (size_t i = 0; i < queue_sizes.size() && i < queue_sizes_.size(); ++i) {
+      setQueueSize(static_cast<int>(i), queue_sizes[i]);
+    }
   }
 
   ApproximateTime(const ApproximateTime & e)
-  : max_interval_duration_(rclcpp::Duration(std::numeric_limits<int32_t>::max(), 999999999))
+  : memory_pool_(e.memory_pool_.upstream_resource())
+    , deques_(std::allocator_arg, std::pmr::polymorphic_allocator<std::byte>(&memory_pool_))
+    , past_(std::allocator_arg, std::pmr::polymorphic_allocator<std::byte>(&memory_pool_))
+    , max_interval_duration_(rclcpp::Duration(std::numeric_limits<int32_t>::max(), 999999999))
+    , deadline_(rclcpp::Duration(0, 0))
   {
     *this = e;
   }
@@ -122,7 +166,10 @@ struct ApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
   ApproximateTime & operator=(const ApproximateTime & rhs)
   {
     parent_ = rhs.parent_;
-    queue_size_ = rhs.queue_size_;
+    queue_sizes_ = rhs.queue_sizes_;
+    queue_spans_ = rhs.queue_spans_;
+    queue_size_tuner_ = rhs.queue_size_tuner_;
+    adaptive_queue_size_ = rhs.adaptive_queue_size_;
     num_non_empty_deques_ = rhs.num_non_empty_deques_;
     pivot_time_ = rhs.pivot_time_;
     pivot_ = rhs.pivot_;
@@ -135,6 +182,16 @@ struct ApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
     has_dropped_messages_ = rhs.has_dropped_messages_;
     inter_message_lower_bounds_ = rhs.inter_message_lower_bounds_;
     warned_about_incorrect_bound_ = rhs.warned_about_incorrect_bound_;
+    learned_bounds_ = rhs.learned_bounds_;
+    learn_bounds_ = rhs.learn_bounds_;
+    bound_percentile_ = rhs.bound_percentile_;
+    bound_margin_ = rhs.bound_margin_;
+    num_bound_violations_ = rhs.num_bound_violations_;
+    head_stamps_ = rhs.head_stamps_;
+    stamp_clock_type_ = rhs.stamp_clock_type_;
+    deadline_ = rhs.deadline_;
+    has_deadline_ = rhs.has_deadline_;
+    num_deadline_publishes_ = rhs.num_deadline_publishes_;
 
     return *this;
   }
@@ -148,11 +205,12 @@ struct ApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
   void checkInterMessageBound()
   {
     namespace mt = message_filters::message_traits;
-    if (warned_about_incorrect_bound_[i]) {
+    if (warned_about_incorrect_bound_[i] || learn_bounds_) {
+      // Learned bounds are checked as they are learned
       return;
     }
-    std::deque<typename std::tuple_element<i, Events>::type> & deque = std::get<i>(deques_);
-    std::vector<typename std::tuple_element<i, Events>::type> & v = std::get<i>(past_);
+    std::pmr::deque<typename std::tuple_element<i, Events>::type> & deque = std::get<i>(deques_);
+    std::pmr::vector<typename std::tuple_element<i, Events>::type> & v = std::get<i>(past_);
     assert(!deque.empty());
     const typename std::tuple_element<i, Messages>::type & msg = *(deque.back()).getMessage();
     rclcpp::Time msg_time =
@@ -195,12 +253,23 @@ struct ApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
   template<int i>
   void add(const typename std::tuple_element<i, Events>::type & evt)
   {
-    std::lock_guard<std::mutex> lock(data_mutex_);
+    std::unique_lock<std::mutex> lock(data_mutex_);
 
-    std::deque<typename std::tuple_element<i, Events>::type> & deque = std::get<i>(deques_);
+    if (adaptive_queue_size_) {
+      tuneQueueSizes<i>(*evt.getMessage());
+    }
+    if (learn_bounds_) {
+      namespace mt = message_filters::message_traits;
+      learnInterMessageBound(
+        i, mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(
+          *evt.getMessage()).nanoseconds());
+    }
+
+    std::pmr::deque<typename std::tuple_element<i, Events>::type> & deque = std::get<i>(deques_);
     deque.push_back(evt);
     if (deque.size() == static_cast<size_t>(1)) {
       // We have just added the first message, so it was empty before
+      updateHeadStamp<i>();
       ++num_non_empty_deques_;
       if (num_non_empty_deques_ == (uint32_t)RealTypeCount::value) {
         // All deques have messages
@@ -210,9 +279,9 @@ struct ApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
       checkInterMessageBound<i>();
     }
     // Check whether we have more messages than allowed in the queue.
-    // Note that during the above call to process(), queue i may contain queue_size_+1 messages.
-    std::vector<typename std::tuple_element<i, Events>::type> & past = std::get<i>(past_);
-    if (deque.size() + past.size() > queue_size_) {
+    // Note that during the above call to process(), queue i may contain queue_sizes_[i]+1
+    // messages, or span more than queue_spans_[i], in which case the oldest ones are dropped.
+    while (isOverLimit<i>()) {
       // Cancel ongoing candidate search, if any:
       num_non_empty_deques_ = 0;  // We will recompute it from scratch
       recover<0>();
@@ -227,6 +296,7 @@ struct ApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
       // Drop the oldest message in the offending topic
       assert(!deque.empty());
       deque.pop_front();
+      updateHeadStamp<i>();
       has_dropped_messages_[i] = true;
       if (pivot_ != NO_PIVOT) {
         // The candidate is no longer valid. Destroy it.
@@ -236,6 +306,15 @@ struct ApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
         process();
       }
     }
+    if (has_deadline_) {
+      namespace mt = message_filters::message_traits;
+      enforceDeadline(
+        mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(*evt.getMessage()));
+    }
+    lock.unlock();
+
+    // Deliver the matched tuples, if any, now that other inputs can be added again
+    parent_->dispatchSignals();
   }
 
   void setAgePenalty(double age_penalty)
@@ -254,6 +333,103 @@ struct ApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
     inter_message_lower_bounds_[i] = lower_bound;
   }
 
+  /**
+   * \brief Override the maximum number of messages kept for input \p i.
+   */
+  void setQueueSize(int i, uint32_t queue_size)
+  {
+    assert(queue_size > 0);
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    queue_sizes_[i] = queue_size;
+  }
+
+  /**
+   * \brief Bound the time covered by the messages kept for input \p i.
+   *
+   * Once the oldest message kept for input \p i is stamped more than \p span before the newest
+   * one, it is dropped as if the queue was full. This can be combined with a queue size, in
+   * which case whichever limit is reached first applies.
+   */
+  void setQueueSpan(int i, rclcpp::Duration span)
+  {
+    assert(span >= rclcpp::Duration(0, 0));
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    queue_spans_[i] = span.nanoseconds();
+  }
+
+  /**
+   * \brief The maximum number of messages currently kept for input \p i.
+   */
+  uint32_t getQueueSize(int i)
+  {
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    return queue_sizes_[i];
+  }
+
+  /**
+   * \brief Size the queues from the observed rates and lags of the inputs.
+   *
+   * Once every input has received a few messages, the queue size of each input follows the
+   * estimate of a QueueSizeTuner, within [\p min_size, \p max_size]. The sizes in use can be read
+   * back with getQueueSize(), and the estimates they come from with getQueueSizeTuner(), so that
+   * settled values can be pinned by passing them to the constructor. Time spans set with
+   * setQueueSpan() still apply.
+   */
+  void enableAdaptiveQueueSize(uint32_t min_size, uint32_t max_size)
+  {
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    queue_size_tuner_ = QueueSizeTuner(RealTypeCount::value, min_size, max_size);
+    adaptive_queue_size_ = true;
+  }
+
+  QueueSizeTuner getQueueSizeTuner()
+  {
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    return queue_size_tuner_;
+  }
+
+  /**
+   * \brief Learn the inter message lower bound of each input from the stamps it receives.
+   *
+   * Once an input has received 33 messages, its bound is set to the \p percentile of its last 32
+   * stamp gaps, reduced by the fraction \p margin, and then follows every new gap. The virtual
+   * candidate search can then prove a candidate optimal, and publish it, without waiting for the
+   * next message of every input. Should a gap shorter than the bound in use arrive, or a stamp
+   * older than the previous one, the bound of that input falls back to 0 and is learned again
+   * from scratch. Replaces the bounds set with setInterMessageLowerBound().
+   */
+  void enableInterMessageLowerBoundEstimation(double percentile = 0.05, double margin = 0.2)
+  {
+    assert(percentile >= 0.0 && percentile <= 1.0);
+    assert(margin >= 0.0 && margin <= 1.0);
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    learn_bounds_ = true;
+    bound_percentile_ = percentile;
+    bound_margin_ = margin;
+    for (int i = 0; i < 9; ++i) {
+      inter_message_lower_bounds_[i] = rclcpp::Duration(0, 0);
+      learned_bounds_[i].count = 0;
+    }
+  }
+
+  /**
+   * \brief The inter message lower bound currently used for input \p i.
+   */
+  rclcpp::Duration getInterMessageLowerBound(int i)
+  {
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    return inter_message_lower_bounds_[i];
+  }
+
+  /**
+   * \brief The number of times a learned bound turned out to be wrong and was dropped.
+   */
+  uint64_t getInterMessageBoundViolationCount()
+  {
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    return num_bound_violations_;
+  }
+
   void setMaxIntervalDuration(rclcpp::Duration max_interval_duration)
   {
     // For correctness we only need age_penalty > -1.0,
@@ -262,16 +438,159 @@ struct ApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
     max_interval_duration_ = max_interval_duration;
   }
 
+  /**
+   * \brief Bound the latency of the output, at the expense of optimality.
+   *
+   * Normally a candidate tuple is only published once it is proven to be the best one, which
+   * can take up to a full queue when an input is slow or stalls. With a deadline, the current
+   * candidate is published as is once a message stamped at least \p deadline after the pivot
+   * time arrives on any input, or when checkDeadline() is called with such a time.
+   */
+  void setDeadline(rclcpp::Duration deadline)
+  {
+    assert(deadline >= rclcpp::Duration(0, 0));
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    deadline_ = deadline;
+    has_deadline_ = true;
+  }
+
+  /**
+   * \brief Publish the current candidate if the deadline has passed at time \p now.
+   *
+   * Meant to be called periodically, e.g. from a timer, so that the deadline is also enforced
+   * when no message arrives. \p now must use the same clock as the message stamps.
+   */
+  void checkDeadline(const rclcpp::Time & now)
+  {
+    std::unique_lock<std::mutex> lock(data_mutex_);
+    if (has_deadline_) {
+      enforceDeadline(now);
+    }
+    lock.unlock();
+
+    parent_->dispatchSignals();
+  }
+
+  /**
+   * \brief The number of candidates that were published because their deadline had passed.
+   */
+  uint64_t getDeadlinePublishCount()
+  {
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    return num_deadline_publishes_;
+  }
+
 private:
+  // Whether input <i> keeps more messages, or a longer time span, than it is allowed to.
+  // assumes data_mutex_ is already locked
+  template<int i>
+  bool isOverLimit()
+  {
+    namespace mt = message_filters::message_traits;
+    typedef typename std::tuple_element<i, Messages>::type M;
+
+    std::pmr::deque<typename std::tuple_element<i, Events>::type> & deque = std::get<i>(deques_);
+    std::pmr::vector<typename std::tuple_element<i, Events>::type> & past = std::get<i>(past_);
+    const size_t size = deque.size() + past.size();
+    if (size > queue_sizes_[i]) {
+      return true;
+    }
+    if (size < 2 || queue_spans_[i] == std::numeric_limits<int64_t>::max()) {
+      return false;
+    }
+    // Messages in past_ are older than those in the deque
+    const M & oldest = past.empty() ? *deque.front().getMessage() : *past.front().getMessage();
+    const M & newest = deque.empty() ? *past.back().getMessage() : *deque.back().getMessage();
+    return mt::TimeStamp<M>::value(newest).nanoseconds() -
+           mt::TimeStamp<M>::value(oldest).nanoseconds() > queue_spans_[i];
+  }
+
+  // Adds the gap between this stamp of input <i> and the previous one to the gaps its bound is
+  // learned from. A gap below the bound in use, or a stamp older than the previous one, means
+  // that the bound was wrong, and that the virtual times computed with it may be too: the bound
+  // then falls back to 0 before the message is processed, and is learned again from scratch.
+  // assumes data_mutex_ is already locked
+  void learnInterMessageBound(int i, int64_t stamp)
+  {
+    LearnedBound & learned = learned_bounds_[i];
+    if (!learned.has_last_stamp) {
+      learned.last_stamp = stamp;
+      learned.has_last_stamp = true;
+      return;
+    }
+    const int64_t gap = stamp - learned.last_stamp;
+    if (gap < 0) {
+      // Out of order: no gap to learn from, and the bound did not hold
+      inter_message_lower_bounds_[i] = rclcpp::Duration(0, 0);
+      learned.count = 0;
+      ++num_bound_violations_;
+      return;
+    }
+    learned.last_stamp = stamp;
+    if (gap < inter_message_lower_bounds_[i].nanoseconds()) {
+      inter_message_lower_bounds_[i] = rclcpp::Duration(0, 0);
+      learned.count = 0;
+      ++num_bound_violations_;
+    }
+    learned.gaps[learned.count % BOUND_WINDOW] = gap;
+    if (++learned.count < BOUND_WINDOW) {
+      return;
+    }
+    std::array<int64_t, BOUND_WINDOW> gaps = learned.gaps;
+    auto nth = gaps.begin() + static_cast<size_t>(bound_percentile_ * (BOUND_WINDOW - 1));
+    std::nth_element(gaps.begin(), nth, gaps.end());
+    inter_message_lower_bounds_[i] = rclcpp::Duration::from_nanoseconds(
+      static_cast<int64_t>(static_cast<double>(*nth) * (1.0 - bound_margin_)));
+  }
+
+  // assumes data_mutex_ is already locked
+  template<int i>
+  void tuneQueueSizes(const typename std::tuple_element<i, Messages>::type & msg)
+  {
+    namespace mt = message_filters::message_traits;
+    queue_size_tuner_.observe(
+      i, mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(msg).nanoseconds());
+    if (!queue_size_tuner_.ready()) {
+      return;
+    }
+    for (size_t k = 0; k < static_cast<size_t>(RealTypeCount::value); ++k) {
+      queue_sizes_[k] = queue_size_tuner_.queueSize(k);
+    }
+  }
+
+  // Refreshes the cached stamp of the head of deque number <i>.
+  // Must be called whenever the front of that deque changes. Does nothing if the deque is empty,
+  // since the cached value is only read while all deques are non empty.
+  template<int i>
+  void updateHeadStamp()
+  {
+    namespace mt = message_filters::message_traits;
+
+    if (i >= RealTypeCount::value) {
+      return;
+    }
+
+    std::pmr::deque<typename std::tuple_element<i, Events>::type> & deque = std::get<i>(deques_);
+    if (deque.empty()) {
+      return;
+    }
+    rclcpp::Time stamp = mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(
+      *deque.front().getMessage());
+    head_stamps_[i] = stamp.nanoseconds();
+    stamp_clock_type_ = stamp.get_clock_type();
+  }
+
   // Assumes that deque number <index> is non empty
   template<int i>
   void dequeDeleteFront()
   {
-    std::deque<typename std::tuple_element<i, Events>::type> & deque = std::get<i>(deques_);
+    std::pmr::deque<typename std::tuple_element<i, Events>::type> & deque = std::get<i>(deques_);
     assert(!deque.empty());
     deque.pop_front();
     if (deque.empty()) {
       --num_non_empty_deques_;
+    } else {
+      updateHeadStamp<i>();
     }
   }
 
@@ -315,13 +634,15 @@ private:
   template<int i>
   void dequeMoveFrontToPast()
   {
-    std::deque<typename std::tuple_element<i, Events>::type> & deque = std::get<i>(deques_);
-    std::vector<typename std::tuple_element<i, Events>::type> & vector = std::get<i>(past_);
+    std::pmr::deque<typename std::tuple_element<i, Events>::type> & deque = std::get<i>(deques_);
+    std::pmr::vector<typename std::tuple_element<i, Events>::type> & vector = std::get<i>(past_);
     assert(!deque.empty());
     vector.push_back(deque.front());
     deque.pop_front();
     if (deque.empty()) {
       --num_non_empty_deques_;
+    } else {
+      updateHeadStamp<i>();
     }
   }
   // Assumes that deque number <index> is non empty
@@ -408,13 +729,16 @@ private:
       return;
     }
 
-    std::vector<typename std::tuple_element<i, Events>::type> & v = std::get<i>(past_);
-    std::deque<typename std::tuple_element<i, Events>::type> & q = std::get<i>(deques_);
+    std::pmr::vector<typename std::tuple_element<i, Events>::type> & v = std::get<i>(past_);
+    std::pmr::deque<typename std::tuple_element<i, Events>::type> & q = std::get<i>(deques_);
     assert(num_messages <= v.size());
-    while (num_messages > 0) {
-      q.push_front(v.back());
-      v.pop_back();
-      num_messages--;
+    if (num_messages > 0) {
+      while (num_messages > 0) {
+        q.push_front(v.back());
+        v.pop_back();
+        num_messages--;
+      }
+      updateHeadStamp<i>();
     }
 
     if (!q.empty()) {
@@ -430,11 +754,14 @@ private:
       return;
     }
 
-    std::vector<typename std::tuple_element<i, Events>::type> & v = std::get<i>(past_);
-    std::deque<typename std::tuple_element<i, Events>::type> & q = std::get<i>(deques_);
-    while (!v.empty()) {
-      q.push_front(v.back());
-      v.pop_back();
+    std::pmr::vector<typename std::tuple_element<i, Events>::type> & v = std::get<i>(past_);
+    std::pmr::deque<typename std::tuple_element<i, Events>::type> & q = std::get<i>(deques_);
+    if (!v.empty()) {
+      while (!v.empty()) {
+        q.push_front(v.back());
+        v.pop_back();
+      }
+      updateHeadStamp<i>();
     }
 
     if (!q.empty()) {
@@ -450,8 +777,8 @@ private:
       return;
     }
 
-    std::vector<typename std::tuple_element<i, Events>::type> & v = std::get<i>(past_);
-    std::deque<typename std::tuple_element<i, Events>::type> & q = std::get<i>(deques_);
+    std::pmr::vector<typename std::tuple_element<i, Events>::type> & v = std::get<i>(past_);
+    std::pmr::deque<typename std::tuple_element<i, Events>::type> & q = std::get<i>(deques_);
     while (!v.empty()) {
       q.push_front(v.back());
       v.pop_back();
@@ -461,6 +788,7 @@ private:
 
     q.pop_front();
     if (!q.empty()) {
+      updateHeadStamp<i>();
       ++num_non_empty_deques_;
     }
   }
@@ -468,8 +796,8 @@ private:
   // Assumes: all deques are non empty, i.e. num_non_empty_deques_ == RealTypeCount::value
   void publishCandidate()
   {
-    // Publish
-    parent_->signal(
+    // Publish, once data_mutex_ is released
+    parent_->enqueueSignal(
       std::get<0>(candidate_), std::get<1>(candidate_), std::get<2>(candidate_),
       std::get<3>(candidate_),
       std::get<4>(candidate_), std::get<5>(candidate_), std::get<6>(candidate_),
@@ -492,103 +820,45 @@ private:
     recoverAndDelete<8>();
   }
 
-  // Assumes: all deques are non empty, i.e. num_non_empty_deques_ == RealTypeCount::value
-  // Returns: the oldest message on the deques
-  void getCandidateStart(uint32_t & start_index, rclcpp::Time & start_time)
+  // Finds, in a single pass, the earliest (start) and latest (end) of the given stamps.
+  // Ties resolve to the lowest index for the start and to the highest index for the end.
+  static void getBoundaryIndices(
+    const std::array<int64_t, 9> & stamps, uint32_t & start_index, uint32_t & end_index)
   {
-    return getCandidateBoundary(start_index, start_time, false);
+    start_index = 0;
+    end_index = 0;
+    for (uint32_t i = 1; i < (uint32_t)RealTypeCount::value; i++) {
+      start_index = stamps[i] < stamps[start_index] ? i : start_index;
+      end_index = stamps[i] >= stamps[end_index] ? i : end_index;
+    }
   }
 
   // Assumes: all deques are non empty, i.e. num_non_empty_deques_ == RealTypeCount::value
-  // Returns: the latest message among the heads of the deques, i.e. the minimum
-  //          time to end an interval started at getCandidateStart_index()
-  void getCandidateEnd(uint32_t & end_index, rclcpp::Time & end_time)
+  // Returns: the oldest message on the deques as the start, and the latest message among the
+  //          heads of the deques, i.e. the minimum time to end an interval started at the start
+  void getCandidateBoundaries(
+    uint32_t & start_index, rclcpp::Time & start_time,
+    uint32_t & end_index, rclcpp::Time & end_time)
   {
-    return getCandidateBoundary(end_index, end_time, true);
-  }
-
-  // ASSUMES: all deques are non-empty
-  // end = true: look for the latest head of deque
-  //       false: look for the earliest head of deque
-  void getCandidateBoundary(uint32_t & index, rclcpp::Time & time, bool end)
-  {
-    namespace mt = message_filters::message_traits;
-
-    M0Event & m0 = std::get<0>(deques_).front();
-    time = mt::TimeStamp<M0>::value(*m0.getMessage());
-    index = 0;
-    if (RealTypeCount::value > 1) {
-      M1Event & m1 = std::get<1>(deques_).front();
-      if ((mt::TimeStamp<M1>::value(*m1.getMessage()) < time) ^ end) {
-        time = mt::TimeStamp<M1>::value(*m1.getMessage());
-        index = 1;
-      }
-    }
-    if (RealTypeCount::value > 2) {
-      M2Event & m2 = std::get<2>(deques_).front();
-      if ((mt::TimeStamp<M2>::value(*m2.getMessage()) < time) ^ end) {
-        time = mt::TimeStamp<M2>::value(*m2.getMessage());
-        index = 2;
-      }
-    }
-    if (RealTypeCount::value > 3) {
-      M3Event & m3 = std::get<3>(deques_).front();
-      if ((mt::TimeStamp<M3>::value(*m3.getMessage()) < time) ^ end) {
-        time = mt::TimeStamp<M3>::value(*m3.getMessage());
-        index = 3;
-      }
-    }
-    if (RealTypeCount::value > 4) {
-      M4Event & m4 = std::get<4>(deques_).front();
-      if ((mt::TimeStamp<M4>::value(*m4.getMessage()) < time) ^ end) {
-        time = mt::TimeStamp<M4>::value(*m4.getMessage());
-        index = 4;
-      }
-    }
-    if (RealTypeCount::value > 5) {
-      M5Event & m5 = std::get<5>(deques_).front();
-      if ((mt::TimeStamp<M5>::value(*m5.getMessage()) < time) ^ end) {
-        time = mt::TimeStamp<M5>::value(*m5.getMessage());
-        index = 5;
-      }
-    }
-    if (RealTypeCount::value > 6) {
-      M6Event & m6 = std::get<6>(deques_).front();
-      if ((mt::TimeStamp<M6>::value(*m6.getMessage()) < time) ^ end) {
-        time = mt::TimeStamp<M6>::value(*m6.getMessage());
-        index = 6;
-      }
-    }
-    if (RealTypeCount::value > 7) {
-      M7Event & m7 = std::get<7>(deques_).front();
-      if ((mt::TimeStamp<M7>::value(*m7.getMessage()) < time) ^ end) {
-        time = mt::TimeStamp<M7>::value(*m7.getMessage());
-        index = 7;
-      }
-    }
-    if (RealTypeCount::value > 8) {
-      M8Event & m8 = std::get<8>(deques_).front();
-      if ((mt::TimeStamp<M8>::value(*m8.getMessage()) < time) ^ end) {
-        time = mt::TimeStamp<M8>::value(*m8.getMessage());
-        index = 8;
-      }
-    }
+    getBoundaryIndices(head_stamps_, start_index, end_index);
+    start_time = rclcpp::Time(head_stamps_[start_index], stamp_clock_type_);
+    end_time = rclcpp::Time(head_stamps_[end_index], stamp_clock_type_);
   }
 
 
   // ASSUMES: we have a pivot and candidate
   template<int i>
-  rclcpp::Time getVirtualTime()
+  int64_t getVirtualTime()
   {
     namespace mt = message_filters::message_traits;
 
     if (i >= RealTypeCount::value) {
-      return rclcpp::Time(0, 0);  // Dummy return value
+      return 0;  // Dummy return value
     }
     assert(pivot_ != NO_PIVOT);
 
-    std::vector<typename std::tuple_element<i, Events>::type> & v = std::get<i>(past_);
-    std::deque<typename std::tuple_element<i, Events>::type> & q = std::get<i>(deques_);
+    std::pmr::vector<typename std::tuple_element<i, Events>::type> & v = std::get<i>(past_);
+    std::pmr::deque<typename std::tuple_element<i, Events>::type> & q = std::get<i>(deques_);
     if (q.empty()) {
       assert(!v.empty());  // Because we have a candidate
       rclcpp::Time last_msg_time =
@@ -596,56 +866,42 @@ private:
         *(v.back()).getMessage());
       rclcpp::Time msg_time_lower_bound = last_msg_time + inter_message_lower_bounds_[i];
       if (msg_time_lower_bound > pivot_time_) {  // Take the max
-        return msg_time_lower_bound;
+        return msg_time_lower_bound.nanoseconds();
       }
-      return pivot_time_;
+      return pivot_time_.nanoseconds();
     }
-    rclcpp::Time current_msg_time =
-      mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(
-      *(q.front()).getMessage());
-    return current_msg_time;
+    return head_stamps_[i];
   }
 
 
   // ASSUMES: we have a pivot and candidate
-  void getVirtualCandidateStart(uint32_t & start_index, rclcpp::Time & start_time)
+  void getVirtualCandidateBoundaries(
+    uint32_t & start_index, rclcpp::Time & start_time,
+    uint32_t & end_index, rclcpp::Time & end_time)
   {
-    return getVirtualCandidateBoundary(start_index, start_time, false);
-  }
+    std::array<int64_t, 9> virtual_times = {
+      getVirtualTime<0>(), getVirtualTime<1>(), getVirtualTime<2>(),
+      getVirtualTime<3>(), getVirtualTime<4>(), getVirtualTime<5>(),
+      getVirtualTime<6>(), getVirtualTime<7>(), getVirtualTime<8>()};
 
-  // ASSUMES: we have a pivot and candidate
-  void getVirtualCandidateEnd(uint32_t & end_index, rclcpp::Time & end_time)
-  {
-    return getVirtualCandidateBoundary(end_index, end_time, true);
+    getBoundaryIndices(virtual_times, start_index, end_index);
+    start_time = rclcpp::Time(virtual_times[start_index], stamp_clock_type_);
+    end_time = rclcpp::Time(virtual_times[end_index], stamp_clock_type_);
   }
 
-  // ASSUMES: we have a pivot and candidate
-  // end = true: look for the latest head of deque
-  //       false: look for the earliest head of deque
-  void getVirtualCandidateBoundary(uint32_t & index, rclcpp::Time & time, bool end)
-  {
-    std::vector<rclcpp::Time> virtual_times(9);
-    virtual_times[0] = getVirtualTime<0>();
-    virtual_times[1] = getVirtualTime<1>();
-    virtual_times[2] = getVirtualTime<2>();
-    virtual_times[3] = getVirtualTime<3>();
-    virtual_times[4] = getVirtualTime<4>();
-    virtual_times[5] = getVirtualTime<5>();
-    virtual_times[6] = getVirtualTime<6>();
-    virtual_times[7] = getVirtualTime<7>();
-    virtual_times[8] = getVirtualTime<8>();
-
-    time = virtual_times[0];
-    index = 0;
-    for (int i = 0; i < RealTypeCount::value; i++) {
-      if ((virtual_times[i] < time) ^ end) {
-        time = virtual_times[i];
-        index = i;
-      }
+
+  // assumes data_mutex_ is already locked
+  void enforceDeadline(const rclcpp::Time & now)
+  {
+    if (pivot_ == NO_PIVOT || now - pivot_time_ < deadline_) {
+      return;
     }
+    ++num_deadline_publishes_;
+    publishCandidate();
+    // The remaining messages may already make up the next candidate
+    process();
   }
 
-
   // assumes data_mutex_ is already locked
   void process()
   {
@@ -654,8 +910,7 @@ private:
       // Find the start and end of the current interval
       rclcpp::Time end_time, start_time;
       uint32_t end_index, start_index;
-      getCandidateEnd(end_index, end_time);
-      getCandidateStart(start_index, start_time);
+      getCandidateBoundaries(start_index, start_time, end_index, end_time);
       for (uint32_t i = 0; i < (uint32_t)RealTypeCount::value; i++) {
         if (i != end_index) {
           // No dropped message could have been better to use than the ones we have,
@@ -719,12 +974,11 @@ private:
         uint32_t num_non_empty_deques_before_virtual_search = num_non_empty_deques_;
 
         // Before giving up, use the rate bounds, if provided, to further try to prove optimality
-        std::vector<int> num_virtual_moves(9, 0);
+        std::array<int, 9> num_virtual_moves{};
         while (1) {
           rclcpp::Time end_time, start_time;
           uint32_t end_index, start_index;
-          getVirtualCandidateEnd(end_index, end_time);
-          getVirtualCandidateStart(start_index, start_time);
+          getVirtualCandidateBoundaries(start_index, start_time, end_index, end_time);
           if ((end_time - candidate_end_) * (1 + age_penalty_) >=
             (pivot_time_ - candidate_start_))
           {
@@ -768,11 +1022,16 @@ private:
   }
 
   Sync * parent_;
-  uint32_t queue_size_;
+  std::vector<uint32_t> queue_sizes_;  // Maximum number of messages kept for each input
+  std::vector<int64_t> queue_spans_;  // Maximum stamp span (ns) kept for each input
+  QueueSizeTuner queue_size_tuner_;
+  bool adaptive_queue_size_{false};  // Whether queue_sizes_ follow queue_size_tuner_
 
   // Special value for the pivot indicating that no pivot has been selected
   static const uint32_t NO_PIVOT = 9;
 
+  // Recycles the memory of deques_ and past_, protected by data_mutex_
+  std::pmr::unsynchronized_pool_resource memory_pool_;
   DequeTuple deques_;
   uint32_t num_non_empty_deques_;
   VectorTuple past_;
@@ -781,6 +1040,8 @@ private:
   rclcpp::Time candidate_end_;
   rclcpp::Time pivot_time_;
   uint32_t pivot_;  // Equal to NO_PIVOT if there is no candidate
+  std::array<int64_t, 9> head_stamps_{};  // Stamp (ns) of the front of each non empty deque
+  rcl_clock_type_t stamp_clock_type_{RCL_ROS_TIME};  // Clock type of the cached stamps
   std::mutex data_mutex_;  // Protects all of the above
 
   rclcpp::Duration max_interval_duration_;  // TODO(anyone): initialize with a parameter
@@ -789,6 +1050,25 @@ private:
   std::vector<bool> has_dropped_messages_;
   std::vector<rclcpp::Duration> inter_message_lower_bounds_;
   std::vector<bool> warned_about_incorrect_bound_;
+
+  // The stamp gaps the bounds are learned from, when enabled
+  static constexpr size_t BOUND_WINDOW = 32;
+  struct LearnedBound
+  {
+    std::array<int64_t, BOUND_WINDOW> gaps{};  // The last gaps, by count modulo BOUND_WINDOW
+    uint64_t count{0};
+    int64_t last_stamp{0};
+    bool has_last_stamp{false};
+  };
+  std::array<LearnedBound, 9> learned_bounds_{};
+  bool learn_bounds_{false};
+  double bound_percentile_{0.05};
+  double bound_margin_{0.2};
+  uint64_t num_bound_violations_{0};
+
+  rclcpp::Duration deadline_;
+  bool has_deadline_;
+  uint64_t num_deadline_publishes_;
 };
 
 }  // namespace sync_policies
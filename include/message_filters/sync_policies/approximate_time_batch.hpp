@@ -0,0 +1,490 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__SYNC_POLICIES__APPROXIMATE_TIME_BATCH_HPP_
+#define MESSAGE_FILTERS__SYNC_POLICIES__APPROXIMATE_TIME_BATCH_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+
+namespace message_filters
+{
+namespace sync_policies
+{
+
+/**
+ * \brief Offline counterpart of the ApproximateTime policy.
+ *
+ * Matches whole recordings at once instead of feeding a Synchronizer one message at a time.
+ * The input is one sorted array of stamps (in nanoseconds) per topic, and the output is the
+ * list of matched tuples, each given as one index per topic into those arrays, in the order
+ * the ApproximateTime policy would have published them had the messages been added in stamp
+ * order (ties going to the lowest topic index first).
+ *
+ * The timeline is cut into chunks that are matched in parallel. Each chunk starts matching a
+ * little before its cut point, so that by the time it reaches the cut it has normally
+ * converged to the state the sequential algorithm would be in. A chunk is only kept if its
+ * state at the cut is identical to the state the previous chunk ended in; otherwise it is
+ * matched again sequentially. The result is therefore always the same as the streaming one.
+ *
+ * \tparam N The number of topics, between 2 and 9.
+ */
+template<std::size_t N>
+class ApproximateTimeBatch
+{
+public:
+  static_assert(N >= 2 && N <= 9, "ApproximateTimeBatch supports between 2 and 9 topics");
+
+  typedef std::array<std::vector<int64_t>, N> Stamps;
+  typedef std::array<std::size_t, N> Indices;
+
+  /**
+   * \param queue_size The maximum number of messages kept per input, as in ApproximateTime.
+   */
+  explicit ApproximateTimeBatch(uint32_t queue_size)
+  : queue_size_(queue_size)
+    , max_interval_duration_(std::numeric_limits<int64_t>::max())
+    , age_penalty_(0.1)
+    , num_threads_(std::max(1u, std::thread::hardware_concurrency()))
+  {
+    assert(queue_size_ > 0);
+    inter_message_lower_bounds_.fill(0);
+  }
+
+  void setAgePenalty(double age_penalty)
+  {
+    assert(age_penalty >= 0);
+    age_penalty_ = age_penalty;
+  }
+
+  void setInterMessageLowerBound(int i, rclcpp::Duration lower_bound)
+  {
+    assert(lower_bound >= rclcpp::Duration(0, 0));
+    inter_message_lower_bounds_[i] = lower_bound.nanoseconds();
+  }
+
+  void setMaxIntervalDuration(rclcpp::Duration max_interval_duration)
+  {
+    assert(max_interval_duration >= rclcpp::Duration(0, 0));
+    max_interval_duration_ = max_interval_duration.nanoseconds();
+  }
+
+  /**
+   * \brief Sets the number of threads used by match(). Defaults to the number of cores.
+   */
+  void setNumThreads(std::size_t num_threads)
+  {
+    num_threads_ = std::max<std::size_t>(1, num_threads);
+  }
+
+  /**
+   * \brief Matches the given stamps.
+   *
+   * \param stamps One array of stamps per topic, each sorted in non decreasing order.
+   * \return The matched tuples, in publication order.
+   */
+  std::vector<Indices> match(const Stamps & stamps) const
+  {
+    // The order in which messages are added, as a sequence of topic indices
+    std::vector<uint8_t> order;
+    mergeOrder(stamps, order);
+
+    // Cut the arrivals into chunks. A chunk needs to be large compared to its warm-up to be
+    // worth matching separately.
+    const std::size_t min_chunk_size = 64 * static_cast<std::size_t>(queue_size_) * N;
+    std::size_t num_chunks = std::min(num_threads_, order.size() / min_chunk_size);
+    num_chunks = std::max<std::size_t>(1, num_chunks);
+
+    std::vector<Chunk> chunks(num_chunks);
+    for (std::size_t k = 0; k < num_chunks; ++k) {
+      chunks[k].begin = order.size() * k / num_chunks;
+      chunks[k].end = order.size() * (k + 1) / num_chunks;
+    }
+    countArrivals(order, chunks);
+    for (std::size_t k = 1; k < num_chunks; ++k) {
+      findWarmUp(stamps, chunks[k]);
+    }
+
+    // Match all chunks but the first speculatively, from an empty state at their warm-up point
+    std::vector<std::thread> workers;
+    for (std::size_t k = 1; k < num_chunks; ++k) {
+      workers.emplace_back(
+        [this, &stamps, &order, &chunks, k]() {
+          Chunk & chunk = chunks[k];
+          Matcher matcher(*this, stamps, chunk.warm_up_arrived);
+          matcher.run(order, chunk.warm_up, chunk.begin, nullptr);
+          chunk.state_at_begin = matcher.state();
+          matcher.run(order, chunk.begin, chunk.end, &chunk.tuples);
+          chunk.state_at_end = matcher.state();
+        });
+    }
+
+    Matcher matcher(*this, stamps, Indices{});
+    std::vector<Indices> tuples;
+    matcher.run(order, chunks[0].begin, chunks[0].end, &tuples);
+
+    for (std::thread & worker : workers) {
+      worker.join();
+    }
+
+    // Stitch the chunks together, re-matching the ones that had not converged at their cut
+    for (std::size_t k = 1; k < num_chunks; ++k) {
+      Chunk & chunk = chunks[k];
+      if (matcher.state() == chunk.state_at_begin) {
+        tuples.insert(tuples.end(), chunk.tuples.begin(), chunk.tuples.end());
+        matcher.setState(chunk.state_at_end);
+      } else {
+        matcher.run(order, chunk.begin, chunk.end, &tuples);
+      }
+    }
+    return tuples;
+  }
+
+private:
+  // Matching state at some point of the arrival sequence. For every topic, the messages in
+  // [past_begin, head) are the past_ vector of ApproximateTime, and the ones in [head, arrived)
+  // are its deque.
+  struct State
+  {
+    Indices past_begin{};
+    Indices head{};
+    Indices arrived{};
+    std::array<bool, N> has_dropped_messages{};
+    std::size_t pivot{N};  // Equal to N if there is no candidate
+    Indices candidate{};
+    int64_t candidate_start{0};
+    int64_t candidate_end{0};
+    int64_t pivot_time{0};
+
+    bool operator==(const State & rhs) const
+    {
+      if (past_begin != rhs.past_begin || head != rhs.head || arrived != rhs.arrived ||
+        has_dropped_messages != rhs.has_dropped_messages || pivot != rhs.pivot)
+      {
+        return false;
+      }
+      // The candidate is meaningless without a pivot
+      return pivot == N || (candidate == rhs.candidate &&
+             candidate_start == rhs.candidate_start && candidate_end == rhs.candidate_end &&
+             pivot_time == rhs.pivot_time);
+    }
+  };
+
+  struct Chunk
+  {
+    std::size_t warm_up{0};  // Arrival the speculative matching starts from
+    std::size_t begin{0};
+    std::size_t end{0};
+    Indices warm_up_arrived{};  // Number of messages per topic before warm_up
+    Indices begin_arrived{};  // Number of messages per topic before begin
+    State state_at_begin;
+    State state_at_end;
+    std::vector<Indices> tuples;
+  };
+
+  // Same algorithm as ApproximateTime::add() and ApproximateTime::process(), working on
+  // indices into the stamp arrays instead of message events.
+  class Matcher
+  {
+public:
+    Matcher(const ApproximateTimeBatch & params, const Stamps & stamps, const Indices & arrived)
+    : params_(params), stamps_(stamps)
+    {
+      s_.past_begin = arrived;
+      s_.head = arrived;
+      s_.arrived = arrived;
+    }
+
+    const State & state() const
+    {
+      return s_;
+    }
+
+    void setState(const State & state)
+    {
+      s_ = state;
+    }
+
+    void run(
+      const std::vector<uint8_t> & order, std::size_t begin, std::size_t end,
+      std::vector<Indices> * tuples)
+    {
+      tuples_ = tuples;
+      for (std::size_t n = begin; n < end; ++n) {
+        add(order[n]);
+      }
+    }
+
+private:
+    void add(std::size_t i)
+    {
+      ++s_.arrived[i];
+      if (s_.arrived[i] - s_.head[i] == 1 && allNonEmpty()) {
+        process();
+      }
+      if (s_.arrived[i] - s_.past_begin[i] > params_.queue_size_) {
+        // Cancel ongoing candidate search, if any, and drop the oldest message of topic i
+        s_.head = s_.past_begin;
+        ++s_.head[i];
+        s_.past_begin[i] = s_.head[i];
+        s_.has_dropped_messages[i] = true;
+        if (s_.pivot != N) {
+          s_.pivot = N;
+          process();
+        }
+      }
+    }
+
+    bool allNonEmpty() const
+    {
+      for (std::size_t i = 0; i < N; ++i) {
+        if (s_.head[i] == s_.arrived[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    int64_t stamp(std::size_t i, std::size_t index) const
+    {
+      return stamps_[i][index];
+    }
+
+    int64_t scaled(int64_t duration) const
+    {
+      return (rclcpp::Duration::from_nanoseconds(duration) * (1 + params_.age_penalty_))
+             .nanoseconds();
+    }
+
+    // Same tie breaking as ApproximateTime::getBoundaryIndices()
+    static void getBoundaryIndices(
+      const std::array<int64_t, N> & times, std::size_t & start_index, std::size_t & end_index)
+    {
+      start_index = 0;
+      end_index = 0;
+      for (std::size_t i = 1; i < N; i++) {
+        start_index = times[i] < times[start_index] ? i : start_index;
+        end_index = times[i] >= times[end_index] ? i : end_index;
+      }
+    }
+
+    void makeCandidate(int64_t start_time, int64_t end_time)
+    {
+      s_.candidate = s_.head;
+      s_.past_begin = s_.head;
+      s_.candidate_start = start_time;
+      s_.candidate_end = end_time;
+    }
+
+    void publishCandidate()
+    {
+      if (tuples_) {
+        tuples_->push_back(s_.candidate);
+      }
+      s_.pivot = N;
+      for (std::size_t i = 0; i < N; ++i) {
+        s_.head[i] = s_.past_begin[i] + 1;
+        s_.past_begin[i] = s_.head[i];
+      }
+    }
+
+    void process()
+    {
+      std::array<int64_t, N> heads;
+      while (allNonEmpty()) {
+        for (std::size_t i = 0; i < N; ++i) {
+          heads[i] = stamp(i, s_.head[i]);
+        }
+        std::size_t start_index, end_index;
+        getBoundaryIndices(heads, start_index, end_index);
+        const int64_t start_time = heads[start_index];
+        const int64_t end_time = heads[end_index];
+        for (std::size_t i = 0; i < N; i++) {
+          if (i != end_index) {
+            s_.has_dropped_messages[i] = false;
+          }
+        }
+        if (s_.pivot == N) {
+          if (end_time - start_time > params_.max_interval_duration_ ||
+            s_.has_dropped_messages[end_index])
+          {
+            ++s_.head[start_index];
+            s_.past_begin[start_index] = s_.head[start_index];
+            continue;
+          }
+          makeCandidate(start_time, end_time);
+          s_.pivot = end_index;
+          s_.pivot_time = end_time;
+        } else if (scaled(end_time - s_.candidate_end) < start_time - s_.candidate_start) {
+          makeCandidate(start_time, end_time);
+        }
+        ++s_.head[start_index];
+
+        if (start_index == s_.pivot ||
+          scaled(end_time - s_.candidate_end) >= s_.pivot_time - s_.candidate_start)
+        {
+          publishCandidate();
+        } else if (!allNonEmpty()) {
+          virtualSearch();
+        }
+      }
+    }
+
+    // Uses the inter message lower bounds to try to prove that the candidate is optimal
+    void virtualSearch()
+    {
+      const Indices head_before_search = s_.head;
+      std::array<int64_t, N> virtual_times;
+      while (1) {
+        for (std::size_t i = 0; i < N; ++i) {
+          if (s_.head[i] == s_.arrived[i]) {
+            virtual_times[i] = std::max(
+              stamp(i, s_.head[i] - 1) + params_.inter_message_lower_bounds_[i], s_.pivot_time);
+          } else {
+            virtual_times[i] = stamp(i, s_.head[i]);
+          }
+        }
+        std::size_t start_index, end_index;
+        getBoundaryIndices(virtual_times, start_index, end_index);
+        const int64_t scaled_end = scaled(virtual_times[end_index] - s_.candidate_end);
+        if (scaled_end >= s_.pivot_time - s_.candidate_start) {
+          publishCandidate();
+          return;
+        }
+        if (scaled_end < virtual_times[start_index] - s_.candidate_start) {
+          s_.head = head_before_search;
+          return;
+        }
+        assert(start_index != s_.pivot);
+        ++s_.head[start_index];
+      }
+    }
+
+    const ApproximateTimeBatch & params_;
+    const Stamps & stamps_;
+    State s_;
+    std::vector<Indices> * tuples_{nullptr};
+  };
+
+  // Merges the stamps into the order in which the messages are added
+  static void mergeOrder(const Stamps & stamps, std::vector<uint8_t> & order)
+  {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      assert(std::is_sorted(stamps[i].begin(), stamps[i].end()));
+      total += stamps[i].size();
+    }
+    order.resize(total);
+    Indices next{};
+    for (std::size_t n = 0; n < total; ++n) {
+      std::size_t oldest = N;
+      for (std::size_t i = 0; i < N; ++i) {
+        if (next[i] < stamps[i].size() &&
+          (oldest == N || stamps[i][next[i]] < stamps[oldest][next[oldest]]))
+        {
+          oldest = i;
+        }
+      }
+      order[n] = static_cast<uint8_t>(oldest);
+      ++next[oldest];
+    }
+  }
+
+  static void countArrivals(const std::vector<uint8_t> & order, std::vector<Chunk> & chunks)
+  {
+    Indices arrived{};
+    std::size_t n = 0;
+    for (Chunk & chunk : chunks) {
+      for (; n < chunk.begin; ++n) {
+        ++arrived[order[n]];
+      }
+      chunk.begin_arrived = arrived;
+    }
+  }
+
+  // Number of messages of each topic added before message number <index> of topic <i>
+  static Indices arrivedBefore(const Stamps & stamps, std::size_t i, std::size_t index)
+  {
+    const int64_t t = stamps[i][index];
+    Indices arrived;
+    for (std::size_t j = 0; j < N; ++j) {
+      if (j < i) {
+        arrived[j] = std::upper_bound(stamps[j].begin(), stamps[j].end(), t) - stamps[j].begin();
+      } else if (j > i) {
+        arrived[j] = std::lower_bound(stamps[j].begin(), stamps[j].end(), t) - stamps[j].begin();
+      } else {
+        arrived[j] = index;
+      }
+    }
+    return arrived;
+  }
+
+  // The state at the beginning of a chunk only involves the last queue_size_ messages of each
+  // topic. Start the speculative matching a further queue_size_ messages earlier on every topic,
+  // which in practice is enough for it to have converged by the beginning of the chunk.
+  void findWarmUp(const Stamps & stamps, Chunk & chunk) const
+  {
+    const std::size_t depth = 2 * static_cast<std::size_t>(queue_size_);
+    chunk.warm_up = chunk.begin;
+    chunk.warm_up_arrived = chunk.begin_arrived;
+    for (std::size_t i = 0; i < N; ++i) {
+      if (chunk.begin_arrived[i] == 0) {
+        continue;
+      }
+      std::size_t first = chunk.begin_arrived[i] > depth ? chunk.begin_arrived[i] - depth : 0;
+      Indices arrived = arrivedBefore(stamps, i, first);
+      std::size_t position = 0;
+      for (std::size_t j = 0; j < N; ++j) {
+        position += arrived[j];
+      }
+      if (position < chunk.warm_up) {
+        chunk.warm_up = position;
+        chunk.warm_up_arrived = arrived;
+      }
+    }
+  }
+
+  uint32_t queue_size_;
+  int64_t max_interval_duration_;
+  double age_penalty_;
+  std::array<int64_t, N> inter_message_lower_bounds_;
+  std::size_t num_threads_;
+};
+
+}  // namespace sync_policies
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__SYNC_POLICIES__APPROXIMATE_TIME_BATCH_HPP_
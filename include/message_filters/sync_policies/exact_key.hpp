@@ -0,0 +1,377 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__SYNC_POLICIES__EXACT_KEY_HPP_
+#define MESSAGE_FILTERS__SYNC_POLICIES__EXACT_KEY_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "message_filters/connection.hpp"
+#include "message_filters/message_traits.hpp"
+#include "message_filters/null_types.hpp"
+#include "message_filters/ring_buffer.hpp"
+#include "message_filters/signal9.hpp"
+#include "message_filters/synchronizer.hpp"
+
+namespace message_filters
+{
+namespace sync_policies
+{
+
+/**
+ * \brief Matches messages that carry the same key, as given by message_traits::MatchKey, rather
+ * than the same stamp.
+ *
+ * Useful when the drivers of the inputs stamp their messages inconsistently but share a frame
+ * counter or sequence number. MatchKey must be specialized for every input type.
+ *
+ * The incomplete tuples are kept in an open addressing hash table, so matching a message costs
+ * the same however many tuples are pending. A tuple is signaled as soon as it is complete. The
+ * incomplete ones are dropped, through the drop signal, oldest first, when more than queue_size
+ * are pending, or once they have aged past the limit set with setMaxAge(). Unlike with ExactTime,
+ * completing a tuple does not drop the older ones, since keys need not be ordered.
+ */
+template<typename M0, typename M1, typename M2 = NullType, typename M3 = NullType,
+  typename M4 = NullType, typename M5 = NullType, typename M6 = NullType,
+  typename M7 = NullType, typename M8 = NullType>
+struct ExactKey : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
+{
+  typedef Synchronizer<ExactKey> Sync;
+  typedef PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8> Super;
+  typedef typename Super::Messages Messages;
+  typedef typename Super::Signal Signal;
+  typedef typename Super::Events Events;
+  typedef typename Super::RealTypeCount RealTypeCount;
+  typedef typename Super::M0Event M0Event;
+  typedef typename Super::M1Event M1Event;
+  typedef typename Super::M2Event M2Event;
+  typedef typename Super::M3Event M3Event;
+  typedef typename Super::M4Event M4Event;
+  typedef typename Super::M5Event M5Event;
+  typedef typename Super::M6Event M6Event;
+  typedef typename Super::M7Event M7Event;
+  typedef typename Super::M8Event M8Event;
+  typedef Events Tuple;
+
+  /**
+   * \param queue_size The maximum number of incomplete tuples kept, 0 for unbounded.
+   */
+  ExactKey(uint32_t queue_size)  // NOLINT(runtime/explicit)
+  : parent_(0)
+    , queue_size_(queue_size)
+    , max_age_(0)
+    , size_(0)
+    , next_serial_(1)
+  {
+    size_t capacity = 16;
+    while (capacity < 2 * static_cast<size_t>(queue_size_)) {
+      capacity *= 2;
+    }
+    slots_.resize(capacity);
+  }
+
+  ExactKey(const ExactKey & e)
+  {
+    *this = e;
+  }
+
+  ExactKey & operator=(const ExactKey & rhs)
+  {
+    parent_ = rhs.parent_;
+    queue_size_ = rhs.queue_size_;
+    max_age_ = rhs.max_age_;
+    slots_ = rhs.slots_;
+    tuples_ = rhs.tuples_;
+    free_tuples_ = rhs.free_tuples_;
+    size_ = rhs.size_;
+    next_serial_ = rhs.next_serial_;
+    order_ = rhs.order_;
+
+    return *this;
+  }
+
+  void initParent(Sync * parent)
+  {
+    parent_ = parent;
+  }
+
+  /**
+   * \brief Drop the incomplete tuples once more than \p max_age newer keys have been received
+   * since they were created. 0, the default, disables the limit.
+   */
+  void setMaxAge(uint64_t max_age)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_age_ = max_age;
+  }
+
+  template<int i>
+  void add(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    assert(parent_);
+
+    namespace mt = message_filters::message_traits;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    size_t n = findOrInsert(
+      mt::MatchKey<typename std::tuple_element<i, Messages>::type>::value(*evt.getMessage()));
+    PendingTuple & pending = tuples_[slots_[n].tuple];
+    auto & event = std::get<i>(pending.tuple);
+    if (!event.getMessage()) {
+      ++pending.count;
+    }
+    event = evt;
+
+    if (pending.count == RealTypeCount::value) {
+      const Tuple & t = pending.tuple;
+      parent_->enqueueSignal(
+        std::get<0>(t), std::get<1>(t), std::get<2>(t),
+        std::get<3>(t), std::get<4>(t), std::get<5>(t),
+        std::get<6>(t), std::get<7>(t), std::get<8>(t));
+      erase(n);
+    }
+    dropAged();
+    lock.unlock();
+
+    // Deliver the matched tuple, if any, now that other inputs can be added again
+    parent_->dispatchSignals();
+  }
+
+  template<class C>
+  Connection registerDropCallback(const C & callback)
+  {
+    return drop_signal_.addCallback(callback);
+  }
+
+  template<class C>
+  Connection registerDropCallback(C & callback)
+  {
+    return drop_signal_.addCallback(callback);
+  }
+
+  template<class C, typename T>
+  Connection registerDropCallback(const C & callback, T * t)
+  {
+    return drop_signal_.addCallback(callback, t);
+  }
+
+  template<class C, typename T>
+  Connection registerDropCallback(C & callback, T * t)
+  {
+    return drop_signal_.addCallback(callback, t);
+  }
+
+private:
+  // The slots only hold the keys, so that probing them stays cheap however large the tuples are
+  struct Slot
+  {
+    uint64_t key{0};
+    uint64_t serial{0};  // Creation order of the tuple, 0 for an empty slot
+    size_t tuple{0};  // Position of the tuple in tuples_
+  };
+
+  struct PendingTuple
+  {
+    Tuple tuple;
+    uint32_t count{0};  // Number of inputs with a message in the tuple
+  };
+
+  // An incomplete tuple, in creation order. Stale once the tuple is complete or dropped.
+  struct Entry
+  {
+    uint64_t key;
+    uint64_t serial;
+  };
+
+  static size_t hash(uint64_t key)
+  {
+    // The finalizer of splitmix64, so that sequential keys spread over the table
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<size_t>(key ^ (key >> 31));
+  }
+
+  // Returns the slot of <key>, or that of the empty slot that ends its probe sequence
+  // assumes mutex_ is already locked
+  size_t find(uint64_t key) const
+  {
+    const size_t mask = slots_.size() - 1;
+    size_t n = hash(key) & mask;
+    while (slots_[n].serial != 0 && slots_[n].key != key) {
+      n = (n + 1) & mask;
+    }
+    return n;
+  }
+
+  // assumes mutex_ is already locked
+  size_t findOrInsert(uint64_t key)
+  {
+    size_t n = find(key);
+    if (slots_[n].serial != 0) {
+      return n;
+    }
+    if (2 * (size_ + 1) > slots_.size()) {
+      grow();
+      n = find(key);
+    }
+    Slot & slot = slots_[n];
+    slot.key = key;
+    slot.serial = next_serial_++;
+    if (free_tuples_.empty()) {
+      slot.tuple = tuples_.size();
+      tuples_.emplace_back();
+    } else {
+      slot.tuple = free_tuples_.back();
+      free_tuples_.pop_back();
+    }
+    ++size_;
+    order_.push_back(Entry{key, slot.serial});
+    if (order_.size() > 2 * size_ + 16) {
+      compactOrder();
+    }
+    return n;
+  }
+
+  // assumes mutex_ is already locked
+  void grow()
+  {
+    std::vector<Slot> old(slots_.size() * 2);
+    old.swap(slots_);
+    const size_t mask = slots_.size() - 1;
+    for (Slot & slot : old) {
+      if (slot.serial != 0) {
+        size_t n = hash(slot.key) & mask;
+        while (slots_[n].serial != 0) {
+          n = (n + 1) & mask;
+        }
+        slots_[n] = std::move(slot);
+      }
+    }
+  }
+
+  // Empties slot <n>, moving back the slots after it that would no longer be reachable
+  // assumes mutex_ is already locked
+  void erase(size_t n)
+  {
+    PendingTuple & pending = tuples_[slots_[n].tuple];
+    pending.tuple = Tuple();
+    pending.count = 0;
+    free_tuples_.push_back(slots_[n].tuple);
+
+    const size_t mask = slots_.size() - 1;
+    size_t hole = n;
+    for (size_t k = (n + 1) & mask; slots_[k].serial != 0; k = (k + 1) & mask) {
+      size_t home = hash(slots_[k].key) & mask;
+      // The slot can stay if its home is cyclically in (hole, k]
+      bool stays = hole <= k ? (hole < home && home <= k) : (hole < home || home <= k);
+      if (!stays) {
+        slots_[hole] = std::move(slots_[k]);
+        hole = k;
+      }
+    }
+    slots_[hole].serial = 0;
+    --size_;
+  }
+
+  // Whether <entry> still refers to an incomplete tuple, whose slot is then returned in <n>
+  // assumes mutex_ is already locked
+  bool isPending(const Entry & entry, size_t & n) const
+  {
+    n = find(entry.key);
+    return slots_[n].serial == entry.serial;
+  }
+
+  // Drops the oldest incomplete tuples while there are too many, or they are too old
+  // assumes mutex_ is already locked
+  void dropAged()
+  {
+    while (!order_.empty()) {
+      size_t n;
+      const Entry & oldest = order_.front();
+      if (!isPending(oldest, n)) {
+        order_.pop_front();
+        continue;
+      }
+      bool too_many = queue_size_ > 0 && size_ > queue_size_;
+      bool too_old = max_age_ > 0 && next_serial_ - 1 - oldest.serial > max_age_;
+      if (!too_many && !too_old) {
+        break;
+      }
+      order_.pop_front();
+      const Tuple & t = tuples_[slots_[n].tuple].tuple;
+      parent_->enqueueDrop(
+        drop_signal_,
+        std::get<0>(t), std::get<1>(t), std::get<2>(t),
+        std::get<3>(t), std::get<4>(t), std::get<5>(t),
+        std::get<6>(t), std::get<7>(t), std::get<8>(t));
+      erase(n);
+    }
+  }
+
+  // Removes the stale entries, which are otherwise only removed once they are the oldest
+  // assumes mutex_ is already locked
+  void compactOrder()
+  {
+    RingBuffer<Entry> pending;
+    for (size_t k = 0; k < order_.size(); ++k) {
+      size_t n;
+      if (isPending(order_[k], n)) {
+        pending.push_back(order_[k]);
+      }
+    }
+    order_ = pending;
+  }
+
+  Sync * parent_;
+
+  uint32_t queue_size_;
+  uint64_t max_age_;
+  // Incomplete tuples, by key, with linear probing. The size is a power of two.
+  std::vector<Slot> slots_;
+  std::vector<PendingTuple> tuples_;  // Storage of the incomplete tuples, reused once complete
+  std::vector<size_t> free_tuples_;  // Positions of the unused elements of tuples_
+  size_t size_;  // Number of incomplete tuples
+  uint64_t next_serial_;
+  RingBuffer<Entry> order_;  // Incomplete tuples, oldest first, and stale entries
+
+  Signal drop_signal_;
+
+  std::mutex mutex_;
+};
+
+}  // namespace sync_policies
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__SYNC_POLICIES__EXACT_KEY_HPP_
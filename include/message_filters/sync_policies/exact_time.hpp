@@ -29,17 +29,22 @@
 #ifndef MESSAGE_FILTERS__SYNC_POLICIES__EXACT_TIME_HPP_
 #define MESSAGE_FILTERS__SYNC_POLICIES__EXACT_TIME_HPP_
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
-#include <deque>
-#include <map>
+#include <limits>
+#include <memory_resource>
 #include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <rclcpp/rclcpp.hpp>
 
 #include "message_filters/connection.hpp"
 #include "message_filters/message_traits.hpp"
 #include "message_filters/null_types.hpp"
+#include "message_filters/queue_size_tuner.hpp"
 #include "message_filters/signal9.hpp"
 #include "message_filters/synchronizer.hpp"
 
@@ -70,13 +75,27 @@ struct ExactTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
   typedef typename Super::M8Event M8Event;
   typedef Events Tuple;
 
-  ExactTime(uint32_t queue_size)  // NOLINT(runtime/explicit)
+  /**
+   * \param queue_size The maximum number of incomplete tuples kept, 0 for unbounded.
+   * \param upstream The memory resource the tuple store draws from. Memory released by the
+   *        store is pooled and reused, so once it has reached its working size no further
+   *        requests are made to \p upstream.
+   */
+  ExactTime(  // NOLINT(runtime/explicit)
+    uint32_t queue_size,
+    std::pmr::memory_resource * upstream = std::pmr::get_default_resource())
   : parent_(0)
     , queue_size_(queue_size)
+    , memory_pool_(upstream)
+    , tuples_(&memory_pool_)
+    , tuples_head_(0)
+    , tuples_size_(0)
   {
   }
 
   ExactTime(const ExactTime & e)
+  : memory_pool_(e.memory_pool_.upstream_resource())
+    , tuples_(&memory_pool_)
   {
     *this = e;
   }
@@ -87,6 +106,12 @@ struct ExactTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
     queue_size_ = rhs.queue_size_;
     last_signal_time_ = rhs.last_signal_time_;
     tuples_ = rhs.tuples_;
+    tuples_head_ = rhs.tuples_head_;
+    tuples_size_ = rhs.tuples_size_;
+    queue_size_tuner_ = rhs.queue_size_tuner_;
+    adaptive_queue_size_ = rhs.adaptive_queue_size_;
+    max_tuple_age_ = rhs.max_tuple_age_;
+    newest_stamp_ = rhs.newest_stamp_;
 
     return *this;
   }
@@ -103,13 +128,26 @@ struct ExactTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
 
     namespace mt = message_filters::message_traits;
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    const int64_t stamp = mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(
+      *evt.getMessage()).nanoseconds();
+    if (adaptive_queue_size_) {
+      queue_size_tuner_.observe(i, stamp);
+      if (queue_size_tuner_.ready()) {
+        queue_size_ = queue_size_tuner_.stampCount();
+      }
+    }
+    newest_stamp_ = std::max(newest_stamp_, stamp);
 
-    Tuple & t = tuples_[mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(
-          *evt.getMessage())];
-    std::get<i>(t) = evt;
+    size_t n = findOrInsertTuple(stamp);
+    std::get<i>(tupleAt(n).tuple) = evt;
 
-    checkTuple(t);
+    checkTuple(n);
+    lock.unlock();
+
+    // Deliver the matched tuple, if any, now that other inputs can be added again
+    parent_->dispatchSignals();
   }
 
   template<class C>
@@ -136,17 +174,142 @@ struct ExactTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
     return drop_signal_.addCallback(callback, t);
   }
 
+  /**
+   * \brief The maximum number of incomplete tuples currently kept, 0 for unbounded.
+   */
+  uint32_t getQueueSize()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_size_;
+  }
+
+  /**
+   * \brief Size the tuple store from the observed rates and lags of the inputs.
+   *
+   * Once every input has received a few messages, the maximum number of incomplete tuples
+   * follows the estimate of a QueueSizeTuner, within [\p min_size, \p max_size]. The size in use
+   * can be read back with getQueueSize(), and the estimates it comes from with
+   * getQueueSizeTuner(), so that a settled value can be pinned by passing it to the constructor.
+   */
+  void enableAdaptiveQueueSize(uint32_t min_size, uint32_t max_size)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_size_tuner_ = QueueSizeTuner(RealTypeCount::value, min_size, max_size);
+    adaptive_queue_size_ = true;
+  }
+
+  QueueSizeTuner getQueueSizeTuner()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_size_tuner_;
+  }
+
+  /**
+   * \brief Drop incomplete tuples once they are older than \p max_age.
+   *
+   * The age of a tuple is measured from its stamp to the newest stamp received on any input, so
+   * that the partial tuples left behind by an input that went silent are dropped, through the
+   * drop callbacks, as soon as the other inputs move on, rather than when queue_size newer tuples
+   * have piled up after them.
+   */
+  void setMaxTupleAge(const rclcpp::Duration & max_age)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_tuple_age_ = max_age.nanoseconds();
+  }
+
   rclcpp::Time getLastSignalTime() const
   {
     return last_signal_time_;
   }
 
 private:
+  struct StampedTuple
+  {
+    int64_t stamp;  // Nanoseconds
+    Tuple tuple;
+  };
+  typedef std::pmr::vector<StampedTuple> V_StampedTuple;
+
+  // The n-th oldest incomplete tuple. Assumes n < tuples_size_
+  StampedTuple & tupleAt(size_t n)
+  {
+    return tuples_[(tuples_head_ + n) & (tuples_.size() - 1)];
+  }
+
+  // Returns the position of the tuple for the given stamp, creating it if needed
   // assumes mutex_ is already locked
-  void checkTuple(Tuple & t)
+  size_t findOrInsertTuple(int64_t stamp)
+  {
+    // Messages mostly arrive in stamp order, so the tuple is usually the newest one or a new one
+    size_t n = tuples_size_;
+    if (n > 0 && tupleAt(n - 1).stamp >= stamp) {
+      size_t low = 0;
+      while (low < n) {
+        size_t mid = low + (n - low) / 2;
+        if (tupleAt(mid).stamp < stamp) {
+          low = mid + 1;
+        } else {
+          n = mid;
+        }
+      }
+      if (tupleAt(n).stamp == stamp) {
+        return n;
+      }
+    }
+
+    if (tuples_size_ == tuples_.size()) {
+      growTuples();
+    }
+    // Shift the newer tuples up by one to make room
+    for (size_t k = tuples_size_; k > n; --k) {
+      tupleAt(k) = std::move(tupleAt(k - 1));
+    }
+    ++tuples_size_;
+    tupleAt(n).stamp = stamp;
+    tupleAt(n).tuple = Tuple();
+    return n;
+  }
+
+  // assumes mutex_ is already locked
+  void growTuples()
+  {
+    V_StampedTuple bigger(tuples_.empty() ? 8 : 2 * tuples_.size(), tuples_.get_allocator());
+    for (size_t k = 0; k < tuples_size_; ++k) {
+      bigger[k] = std::move(tupleAt(k));
+    }
+    tuples_.swap(bigger);
+    tuples_head_ = 0;
+  }
+
+  // Erases the <count> oldest tuples at once
+  // assumes mutex_ is already locked
+  void eraseOldestTuples(size_t count)
+  {
+    for (size_t k = 0; k < count; ++k) {
+      tupleAt(k).tuple = Tuple();
+    }
+    tuples_head_ = (tuples_head_ + count) & (tuples_.size() - 1);
+    tuples_size_ -= count;
+  }
+
+  // assumes mutex_ is already locked
+  void dropTuple(size_t n)
+  {
+    Tuple & t = tupleAt(n).tuple;
+    parent_->enqueueDrop(
+      drop_signal_,
+      std::get<0>(t), std::get<1>(t), std::get<2>(t),
+      std::get<3>(t), std::get<4>(t), std::get<5>(t),
+      std::get<6>(t), std::get<7>(t), std::get<8>(t));
+  }
+
+  // assumes mutex_ is already locked
+  void checkTuple(size_t n)
   {
     namespace mt = message_filters::message_traits;
 
+    Tuple & t = tupleAt(n).tuple;
     bool full = true;
     full = full && static_cast<bool>(std::get<0>(t).getMessage());
     full = full && static_cast<bool>(std::get<1>(t).getMessage());
@@ -166,50 +329,31 @@ private:
       static_cast<bool>(std::get<8>(t).getMessage()) : true);
 
     if (full) {
-      parent_->signal(
+      parent_->enqueueSignal(
         std::get<0>(t), std::get<1>(t), std::get<2>(t),
         std::get<3>(t), std::get<4>(t), std::get<5>(t),
         std::get<6>(t), std::get<7>(t), std::get<8>(t));
 
       last_signal_time_ = mt::TimeStamp<M0>::value(*std::get<0>(t).getMessage());
 
-      tuples_.erase(last_signal_time_);
-
-      clearOldTuples();
+      // The tuples are sorted by time, so the older ones, which can no longer complete,
+      // are exactly the ones before this one
+      for (size_t k = 0; k < n; ++k) {
+        dropTuple(k);
+      }
+      eraseOldestTuples(n + 1);
     }
 
     if (queue_size_ > 0) {
-      while (tuples_.size() > queue_size_) {
-        Tuple & t2 = tuples_.begin()->second;
-        drop_signal_.call(
-          std::get<0>(t2), std::get<1>(t2), std::get<2>(t2),
-          std::get<3>(t2), std::get<4>(t2), std::get<5>(t2),
-          std::get<6>(t2), std::get<7>(t2), std::get<8>(t2));
-        tuples_.erase(tuples_.begin());
+      while (tuples_size_ > queue_size_) {
+        dropTuple(0);
+        eraseOldestTuples(1);
       }
     }
-  }
 
-  // assumes mutex_ is already locked
-  void clearOldTuples()
-  {
-    typename M_TimeToTuple::iterator it = tuples_.begin();
-    typename M_TimeToTuple::iterator end = tuples_.end();
-    for (; it != end; ) {
-      if (it->first <= last_signal_time_) {
-        typename M_TimeToTuple::iterator old = it;
-        ++it;
-
-        Tuple & t = old->second;
-        drop_signal_.call(
-          std::get<0>(t), std::get<1>(t), std::get<2>(t),
-          std::get<3>(t), std::get<4>(t), std::get<5>(t),
-          std::get<6>(t), std::get<7>(t), std::get<8>(t));
-        tuples_.erase(old);
-      } else {
-        // the map is sorted by time, so we can ignore anything after this if this one's time is ok
-        break;
-      }
+    while (tuples_size_ > 0 && newest_stamp_ - tupleAt(0).stamp > max_tuple_age_) {
+      dropTuple(0);
+      eraseOldestTuples(1);
     }
   }
 
@@ -217,9 +361,18 @@ private:
   Sync * parent_;
 
   uint32_t queue_size_;
-  typedef std::map<rclcpp::Time, Tuple> M_TimeToTuple;
-  M_TimeToTuple tuples_;
+  // Recycles the storage of tuples_, protected by mutex_
+  std::pmr::unsynchronized_pool_resource memory_pool_;
+  // Incomplete tuples sorted by stamp, in a ring buffer whose size is a power of two
+  V_StampedTuple tuples_;
+  size_t tuples_head_;
+  size_t tuples_size_;
   rclcpp::Time last_signal_time_;
+  QueueSizeTuner queue_size_tuner_;
+  bool adaptive_queue_size_{false};  // Whether queue_size_ follows queue_size_tuner_
+  // Nanoseconds, incomplete tuples older than this relative to newest_stamp_ are dropped
+  int64_t max_tuple_age_{std::numeric_limits<int64_t>::max()};
+  int64_t newest_stamp_{0};  // Newest stamp received on any input, in nanoseconds
 
   Signal drop_signal_;
 
@@ -0,0 +1,252 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__SYNC_POLICIES__GREEDY_TIME_HPP_
+#define MESSAGE_FILTERS__SYNC_POLICIES__GREEDY_TIME_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include <rclcpp/rclcpp.hpp>
+
+#include "message_filters/message_traits.hpp"
+#include "message_filters/null_types.hpp"
+#include "message_filters/ring_buffer.hpp"
+#include "message_filters/signal9.hpp"
+#include "message_filters/synchronizer.hpp"
+
+namespace message_filters
+{
+namespace sync_policies
+{
+
+/**
+ * \brief Signals a tuple as soon as every input has a message within a window of the newest
+ * arrival.
+ *
+ * When a message arrives, each other input is searched, from its newest message back to at most
+ * the search depth, for the message nearest in time to the new one that is within the window
+ * of it. If every input has one, the tuple is signaled right away, and the matched messages, as
+ * well as those received before them on the same input, are discarded. Otherwise the new message
+ * waits for a later arrival to match it.
+ *
+ * Each message thus costs a bounded amount of work, and a tuple is signaled as soon as the last
+ * of its messages arrives, unlike with ApproximateTime, which holds messages until it has proven
+ * that no better tuple can form. In exchange a tuple is not always the tightest one possible, and
+ * messages that a better tuple would have used can be skipped.
+ */
+template<typename M0, typename M1, typename M2 = NullType, typename M3 = NullType,
+  typename M4 = NullType, typename M5 = NullType, typename M6 = NullType,
+  typename M7 = NullType, typename M8 = NullType>
+struct GreedyTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
+{
+  typedef Synchronizer<GreedyTime> Sync;
+  typedef PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8> Super;
+  typedef typename Super::Messages Messages;
+  typedef typename Super::Signal Signal;
+  typedef typename Super::Events Events;
+  typedef typename Super::RealTypeCount RealTypeCount;
+  typedef typename Super::M0Event M0Event;
+  typedef typename Super::M1Event M1Event;
+  typedef typename Super::M2Event M2Event;
+  typedef typename Super::M3Event M3Event;
+  typedef typename Super::M4Event M4Event;
+  typedef typename Super::M5Event M5Event;
+  typedef typename Super::M6Event M6Event;
+  typedef typename Super::M7Event M7Event;
+  typedef typename Super::M8Event M8Event;
+  typedef Events Tuple;
+
+  /**
+   * \param queue_size The maximum number of messages kept per input, 0 for unbounded.
+   * \param window The largest stamp difference between a newly arrived message and each message
+   *        it is matched with. The spread of a tuple is therefore at most \p window while the
+   *        messages arrive in stamp order, but can reach twice that with out-of-order arrivals.
+   */
+  GreedyTime(uint32_t queue_size, rclcpp::Duration window)
+  : parent_(0)
+    , queue_size_(queue_size)
+    , window_(window.nanoseconds())
+    , search_depth_(4)
+  {
+  }
+
+  GreedyTime(const GreedyTime & e)
+  {
+    *this = e;
+  }
+
+  GreedyTime & operator=(const GreedyTime & rhs)
+  {
+    parent_ = rhs.parent_;
+    queue_size_ = rhs.queue_size_;
+    window_ = rhs.window_;
+    search_depth_ = rhs.search_depth_;
+    queues_ = rhs.queues_;
+
+    return *this;
+  }
+
+  void initParent(Sync * parent)
+  {
+    parent_ = parent;
+  }
+
+  /**
+   * \brief Set how many of the newest messages of each input are searched for a match.
+   * The default is 4.
+   */
+  void setSearchDepth(uint32_t search_depth)
+  {
+    assert(search_depth > 0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    search_depth_ = search_depth;
+  }
+
+  template<int i>
+  void add(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    assert(parent_);
+
+    namespace mt = message_filters::message_traits;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto & queue = std::get<i>(queues_);
+    int64_t stamp = mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(
+      *evt.getMessage()).nanoseconds();
+    queue.push_back(Entry<i>{stamp, evt});
+    if (queue_size_ > 0 && queue.size() > queue_size_) {
+      queue.pop_front();
+    }
+
+    Positions positions;
+    positions[i] = queue.size() - 1;
+    if (findMatches(i, stamp, positions, std::make_index_sequence<9u>())) {
+      signal(positions, std::make_index_sequence<9u>());
+    }
+    lock.unlock();
+
+    // Deliver the matched tuple, if any, now that other inputs can be added again
+    parent_->dispatchSignals();
+  }
+
+private:
+  template<int i>
+  struct Entry
+  {
+    int64_t stamp;  // Nanoseconds
+    typename std::tuple_element<i, Events>::type event;
+  };
+
+  typedef std::tuple<RingBuffer<Entry<0>>, RingBuffer<Entry<1>>, RingBuffer<Entry<2>>,
+      RingBuffer<Entry<3>>, RingBuffer<Entry<4>>, RingBuffer<Entry<5>>, RingBuffer<Entry<6>>,
+      RingBuffer<Entry<7>>, RingBuffer<Entry<8>>> Queues;
+  // Position of the matched message in each queue
+  typedef std::array<size_t, 9> Positions;
+
+  template<size_t ... Is>
+  bool findMatches(
+    int anchor, int64_t stamp, Positions & positions, std::index_sequence<Is...> const &) const
+  {
+    return (findMatch<Is>(anchor, stamp, positions[Is]) && ...);
+  }
+
+  // Finds the message of input i nearest to <stamp> among the newest search_depth_ ones
+  // assumes mutex_ is already locked
+  template<int i>
+  bool findMatch(int anchor, int64_t stamp, size_t & position) const
+  {
+    if (i == anchor || i >= RealTypeCount::value) {
+      return true;
+    }
+    const auto & queue = std::get<i>(queues_);
+    int64_t best = window_;
+    bool found = false;
+    size_t searched = std::min<size_t>(search_depth_, queue.size());
+    for (size_t n = queue.size() - searched; n < queue.size(); ++n) {
+      int64_t distance = queue[n].stamp - stamp;
+      distance = distance < 0 ? -distance : distance;
+      // On equal distances, the newer one
+      if (distance <= best) {
+        best = distance;
+        position = n;
+        found = true;
+      }
+    }
+    return found;
+  }
+
+  // Signals the matched messages, and discards them with the ones received before them
+  // assumes mutex_ is already locked
+  template<size_t ... Is>
+  void signal(const Positions & positions, std::index_sequence<Is...> const &)
+  {
+    Tuple t;
+    ((takeMatch<Is>(t, positions[Is])), ...);
+    parent_->enqueueSignal(
+      std::get<0>(t), std::get<1>(t), std::get<2>(t),
+      std::get<3>(t), std::get<4>(t), std::get<5>(t),
+      std::get<6>(t), std::get<7>(t), std::get<8>(t));
+  }
+
+  // assumes mutex_ is already locked
+  template<int i>
+  void takeMatch(Tuple & t, size_t position)
+  {
+    if (i >= RealTypeCount::value) {
+      return;
+    }
+    auto & queue = std::get<i>(queues_);
+    std::get<i>(t) = queue[position].event;
+    for (size_t n = 0; n <= position; ++n) {
+      queue.pop_front();
+    }
+  }
+
+  Sync * parent_;
+
+  uint32_t queue_size_;
+  int64_t window_;  // Nanoseconds
+  uint32_t search_depth_;
+
+  Queues queues_;  // In arrival order
+
+  std::mutex mutex_;
+};
+
+}  // namespace sync_policies
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__SYNC_POLICIES__GREEDY_TIME_HPP_
@@ -43,8 +43,9 @@ Synchronizer<latest_policy> sync_policies(latest_policy(), caminfo_sub, limage_s
 sync_policies.registerCallback(callback);
 \endverbatim
 
+ * The rates are measured from the receipt time of each message by default.
  * May also take an instance of a `rclcpp::Clock::SharedPtr` from `rclpp::Node::get_clock()`
- * to use the node's time source (e.g. sim time) as in:
+ * to use the node's time source (e.g. sim time) instead, as in:
 \verbatim
 typedef LatestTime<sensor_msgs::CameraInfo, sensor_msgs::Image, sensor_msgs::Image> latest_policy;
 Synchronizer<latest_policy> sync_policies(latest_policy(node->get_clock()), caminfo_sub, limage_sub, rimage_sub);
@@ -64,8 +65,9 @@ void callback(const sensor_msgs::CameraInfo::ConstPtr &, const sensor_msgs::Imag
 #include <algorithm>
 #include <cmath>
 #include <memory>
-#include <numeric>
+#include <memory_resource>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include <rclcpp/rclcpp.hpp>
@@ -99,17 +101,31 @@ struct LatestTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
   typedef std::tuple<double, double, double> RateConfig;
 
   LatestTime()
-  : LatestTime(rclcpp::Clock::SharedPtr(new rclcpp::Clock(RCL_ROS_TIME)))
+  : LatestTime(rclcpp::Clock::SharedPtr())
   {
   }
 
-  explicit LatestTime(rclcpp::Clock::SharedPtr clock)
+  /**
+   * \param clock The clock used to measure the rate of each input. If null, the receipt time
+   *        of each message is used instead, which avoids reading a clock for every message.
+   * \param upstream The memory resource the internal containers draw from. They are only
+   *        grown while the first message of each input arrives.
+   */
+  explicit LatestTime(
+    rclcpp::Clock::SharedPtr clock,
+    std::pmr::memory_resource * upstream = std::pmr::get_default_resource())
   : parent_(0),
+    rates_(upstream),
+    sorted_idx_(upstream),
+    rate_configs_(upstream),
     ros_clock_{clock}
   {
   }
 
   LatestTime(const LatestTime & e)
+  : rates_(e.rates_.get_allocator()),
+    sorted_idx_(e.sorted_idx_.get_allocator()),
+    rate_configs_(e.rate_configs_.get_allocator())
   {
     *this = e;
   }
@@ -119,6 +135,8 @@ struct LatestTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
     parent_ = rhs.parent_;
     events_ = rhs.events_;
     rates_ = rhs.rates_;
+    sorted_idx_ = rhs.sorted_idx_;
+    rate_configs_ = rhs.rate_configs_;
     ros_clock_ = rhs.ros_clock_;
 
     return *this;
@@ -139,9 +157,20 @@ struct LatestTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
     rate_configs_.assign(1U, config);
   }
 
+  /**
+   * \brief Change the clock used to measure the rate of each input, null for the receipt times.
+   *
+   * The times measured so far cannot be compared with those of another clock, so the policy
+   * starts over as if no message had been received: the rates are estimated again, and nothing
+   * is published until each input has received a message with the new clock.
+   */
   void setClock(rclcpp::Clock::SharedPtr clock)
   {
+    std::lock_guard<std::mutex> lock(data_mutex_);
     ros_clock_ = clock;
+    events_ = Events();
+    rates_.clear();
+    sorted_idx_.clear();
   }
 
   template<int i>
@@ -149,10 +178,10 @@ struct LatestTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
   {
     assert(parent_);
 
-    std::lock_guard<std::mutex> lock(data_mutex_);
+    std::unique_lock<std::mutex> lock(data_mutex_);
 
     if (!received_msg<i>()) {
-      initialize_rate<i>();
+      initialize_rate<i>(current_time(evt));
       // wait until we get each message once to publish
       // then wait until we got each message twice to compute rates
       // NOTE: this will drop a few messages of the faster topics until
@@ -163,17 +192,30 @@ struct LatestTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
     }
 
     std::get<i>(events_) = evt;
-    rclcpp::Time now = ros_clock_->now();
+    rclcpp::Time now = current_time(evt);
     bool valid_rate = rates_[i].compute_hz(now);
+    if (valid_rate) {
+      update_sorted_index(i);
+    }
     if (valid_rate && (i == find_pivot(now)) && is_full()) {
       publish();
     }
+    lock.unlock();
+
+    // Deliver the tuple, if any, now that other inputs can be added again
+    parent_->dispatchSignals();
   }
 
 private:
+  template<class Event>
+  rclcpp::Time current_time(const Event & evt) const
+  {
+    return ros_clock_ ? ros_clock_->now() : evt.getReceiptTime();
+  }
+
   // assumed data_mutex_ is locked
   template<int i>
-  void initialize_rate()
+  void initialize_rate(const rclcpp::Time & now)
   {
     if (rate_configs_.size() > 0U) {
       double rate_ema_alpha{Rate::DEFAULT_RATE_EMA_ALPHA};
@@ -192,19 +234,21 @@ private:
       }
       rates_.push_back(
         Rate(
-          ros_clock_->now(),
+          now,
           rate_ema_alpha,
           error_ema_alpha,
           rate_step_change_margin_factor));
     } else {
-      rates_.push_back(Rate(ros_clock_->now()));
+      rates_.push_back(Rate(now));
     }
+    sorted_idx_.push_back(rates_.size() - 1U);
+    update_sorted_index(rates_.size() - 1U);
   }
 
-  // assumed data_mutex_ is locked
+  // assumed data_mutex_ is locked, the tuple is delivered once it is released
   void publish()
   {
-    parent_->signal(
+    parent_->enqueueSignal(
       std::get<0>(events_), std::get<1>(events_), std::get<2>(events_),
       std::get<3>(events_), std::get<4>(events_), std::get<5>(events_),
       std::get<6>(events_), std::get<7>(events_), std::get<8>(events_));
@@ -284,23 +328,28 @@ private:
     }
   };
 
+  // Whether rate <a> comes before rate <b> in sorted_idx_: by decreasing rate, and by index
+  // for equal rates, as a stable sort would order them
+  bool is_sorted_before(std::size_t a, std::size_t b) const
+  {
+    return rates_[a] > rates_[b] || (!(rates_[b] > rates_[a]) && a < b);
+  }
+
+  // Moves rate <idx> to its place in sorted_idx_ after it changed. The other indices are
+  // already sorted, so nothing moves unless the rate crossed one of its neighbours.
   // assumed data_mutex_ is locked
-  template<typename T>
-  std::vector<std::size_t> sort_indices(const std::vector<T> & v)
+  void update_sorted_index(std::size_t idx)
   {
-    // initialize original index locations
-    std::vector<std::size_t> idx(v.size());
-    std::iota(idx.begin(), idx.end(), 0U);
-
-    // sort indexes based on comparing values in v
-    // using std::stable_sort instead of std::sort
-    // to avoid unnecessary index re-orderings
-    // when v contains elements of equal values
-    std::stable_sort(
-      idx.begin(), idx.end(),
-      [&v](std::size_t i1, std::size_t i2) {return v[i1] > v[i2];});
-
-    return idx;
+    std::size_t pos = static_cast<std::size_t>(
+      std::find(sorted_idx_.begin(), sorted_idx_.end(), idx) - sorted_idx_.begin());
+    while (pos > 0U && is_sorted_before(idx, sorted_idx_[pos - 1U])) {
+      std::swap(sorted_idx_[pos], sorted_idx_[pos - 1U]);
+      --pos;
+    }
+    while (pos + 1U < sorted_idx_.size() && is_sorted_before(sorted_idx_[pos + 1U], idx)) {
+      std::swap(sorted_idx_[pos], sorted_idx_[pos + 1U]);
+      ++pos;
+    }
   }
 
   // assumed data_mutex_ is locked
@@ -329,11 +378,8 @@ private:
   // assumed data_mutex_ is locked
   int find_pivot(const rclcpp::Time & now)
   {
-    // find arg max rate
-    std::vector<std::size_t> sorted_idx = sort_indices(rates_);
-
     // use fastest message that isn't late as pivot
-    for (size_t pivot : sorted_idx) {
+    for (size_t pivot : sorted_idx_) {
       double period = (now - rates_[pivot].prev).seconds();
       if (period == 0.0) {
         if (rates_[pivot].hz > 0.0) {
@@ -369,14 +415,15 @@ private:
 
   Sync * parent_;
   Events events_;
-  std::vector<Rate> rates_;
+  std::pmr::vector<Rate> rates_;
+  std::pmr::vector<std::size_t> sorted_idx_;  // Indices of rates_ by decreasing rate
   std::mutex data_mutex_;  // Protects all of the above
 
-  std::vector<RateConfig> rate_configs_;
+  std::pmr::vector<RateConfig> rate_configs_;
 
   const int NO_PIVOT{9};
 
-  rclcpp::Clock::SharedPtr ros_clock_{nullptr};
+  rclcpp::Clock::SharedPtr ros_clock_{nullptr};  // Null to use the receipt times
 };
 
 }  // namespace sync_policies
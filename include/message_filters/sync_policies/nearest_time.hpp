@@ -0,0 +1,418 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__SYNC_POLICIES__NEAREST_TIME_HPP_
+#define MESSAGE_FILTERS__SYNC_POLICIES__NEAREST_TIME_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include <rclcpp/rclcpp.hpp>
+
+#include "message_filters/connection.hpp"
+#include "message_filters/message_traits.hpp"
+#include "message_filters/null_types.hpp"
+#include "message_filters/ring_buffer.hpp"
+#include "message_filters/shared_event_buffer.hpp"
+#include "message_filters/signal9.hpp"
+#include "message_filters/synchronizer.hpp"
+
+namespace message_filters
+{
+namespace sync_policies
+{
+
+/**
+ * \brief Pairs every message of the first input, the pivot, with the nearest-in-time message of
+ * each of the other inputs.
+ *
+ * Each pivot message is signaled once every other input has received a message stamped at or
+ * after it, that is as soon as its later neighbor on the slowest input arrives: the nearest
+ * message is then one of the two neighbors, found with a binary search in that input's buffer,
+ * which is sorted by stamp. On equal distances the earlier neighbor is used. Secondary messages
+ * may be paired with any number of pivot messages, and are only discarded once no later pivot
+ * can use them.
+ *
+ * Pivot messages are never skipped in favour of a better tuple as with ApproximateTime. A pivot
+ * message is dropped, through the drop signal, only if some input has no message within the
+ * tolerance of it, see setTolerance(). If an input stalls and more than queue_size pivot messages
+ * are waiting, the oldest is paired with the nearest messages received so far.
+ *
+ * Several policies reading the same topics can share a single copy of the messages of the
+ * secondary inputs, see setSharedBuffer().
+ */
+template<typename M0, typename M1, typename M2 = NullType, typename M3 = NullType,
+  typename M4 = NullType, typename M5 = NullType, typename M6 = NullType,
+  typename M7 = NullType, typename M8 = NullType>
+struct NearestTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
+{
+  typedef Synchronizer<NearestTime> Sync;
+  typedef PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8> Super;
+  typedef typename Super::Messages Messages;
+  typedef typename Super::Signal Signal;
+  typedef typename Super::Events Events;
+  typedef typename Super::RealTypeCount RealTypeCount;
+  typedef typename Super::M0Event M0Event;
+  typedef typename Super::M1Event M1Event;
+  typedef typename Super::M2Event M2Event;
+  typedef typename Super::M3Event M3Event;
+  typedef typename Super::M4Event M4Event;
+  typedef typename Super::M5Event M5Event;
+  typedef typename Super::M6Event M6Event;
+  typedef typename Super::M7Event M7Event;
+  typedef typename Super::M8Event M8Event;
+  typedef Events Tuple;
+
+  /**
+   * \param queue_size The maximum number of messages kept per input, 0 for unbounded.
+   */
+  NearestTime(uint32_t queue_size)  // NOLINT(runtime/explicit)
+  : parent_(0)
+    , queue_size_(queue_size)
+    , tolerance_(std::numeric_limits<int64_t>::max())
+  {
+  }
+
+  NearestTime(const NearestTime & e)
+  {
+    *this = e;
+  }
+
+  NearestTime & operator=(const NearestTime & rhs)
+  {
+    parent_ = rhs.parent_;
+    queue_size_ = rhs.queue_size_;
+    tolerance_ = rhs.tolerance_;
+    buffers_ = rhs.buffers_;
+    cursors_ = rhs.cursors_;
+
+    return *this;
+  }
+
+  void initParent(Sync * parent)
+  {
+    parent_ = parent;
+  }
+
+  /**
+   * \brief Read the messages of input \p i from a buffer shared with other policies, instead of
+   * keeping a copy of them.
+   *
+   * Input \p i of the synchronizer must be connected to the output of \p buffer, so that the
+   * policy is notified after each message has been added to it. Must be called on the
+   * synchronizer, before any message is received: a copy of the policy reads through its own
+   * cursor, and a cursor that is no longer read keeps the buffer from discarding anything.
+   */
+  template<int i>
+  void setSharedBuffer(
+    const std::shared_ptr<SharedEventBuffer<typename std::tuple_element<i, Messages>::type>> &
+    buffer)
+  {
+    static_assert(i > 0, "The pivot input cannot be shared");
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::get<i>(cursors_) = std::tuple_element_t<i, Cursors>(buffer);
+    std::get<i>(buffers_).clear();
+  }
+
+  /**
+   * \brief Set the largest stamp difference between a pivot message and the messages paired
+   * with it. Unlimited by default.
+   */
+  void setTolerance(const rclcpp::Duration & tolerance)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tolerance_ = tolerance.nanoseconds();
+  }
+
+  template<int i>
+  void add(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    assert(parent_);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto & cursor = std::get<i>(cursors_);
+    if (cursor.attached()) {
+      // The shared buffer already holds the message
+      auto buffer_lock = cursor.lock();
+      if (queue_size_ > 0 && cursor.size() > queue_size_) {
+        cursor.pop_front();
+      }
+      buffer_lock.unlock();
+      process();
+      lock.unlock();
+      parent_->dispatchSignals();
+      return;
+    }
+
+    auto & buffer = std::get<i>(buffers_);
+    int64_t stamp = stampOf<i>(evt);
+    buffer.push_back(evt);
+    // Move it back to its place if it arrived out of order
+    for (size_t n = buffer.size() - 1; n > 0 && stamp < stampOf<i>(buffer[n - 1]); --n) {
+      std::swap(buffer[n], buffer[n - 1]);
+    }
+
+    if (i == 0) {
+      if (queue_size_ > 0 && buffer.size() > queue_size_) {
+        // Some input stalled; do not wait for it any longer
+        signalPivot();
+      }
+    } else if (queue_size_ > 0 && buffer.size() > queue_size_) {
+      buffer.pop_front();
+    }
+    process();
+    lock.unlock();
+
+    // Deliver the matched tuples, if any, now that other inputs can be added again
+    parent_->dispatchSignals();
+  }
+
+  template<class C>
+  Connection registerDropCallback(const C & callback)
+  {
+    return drop_signal_.addCallback(callback);
+  }
+
+  template<class C>
+  Connection registerDropCallback(C & callback)
+  {
+    return drop_signal_.addCallback(callback);
+  }
+
+  template<class C, typename T>
+  Connection registerDropCallback(const C & callback, T * t)
+  {
+    return drop_signal_.addCallback(callback, t);
+  }
+
+  template<class C, typename T>
+  Connection registerDropCallback(C & callback, T * t)
+  {
+    return drop_signal_.addCallback(callback, t);
+  }
+
+private:
+  // Per input messages sorted by stamp. Those of input 0 are the pivot messages not signaled yet
+  typedef std::tuple<RingBuffer<M0Event>, RingBuffer<M1Event>, RingBuffer<M2Event>,
+      RingBuffer<M3Event>, RingBuffer<M4Event>, RingBuffer<M5Event>, RingBuffer<M6Event>,
+      RingBuffer<M7Event>, RingBuffer<M8Event>> Buffers;
+  // Positions in the shared buffers, for the inputs set up with setSharedBuffer()
+  typedef std::tuple<typename SharedEventBuffer<M0>::Cursor,
+      typename SharedEventBuffer<M1>::Cursor, typename SharedEventBuffer<M2>::Cursor,
+      typename SharedEventBuffer<M3>::Cursor, typename SharedEventBuffer<M4>::Cursor,
+      typename SharedEventBuffer<M5>::Cursor, typename SharedEventBuffer<M6>::Cursor,
+      typename SharedEventBuffer<M7>::Cursor, typename SharedEventBuffer<M8>::Cursor> Cursors;
+
+  // Gives the messages of one of the policy's own buffers the interface of a Cursor
+  template<int i>
+  struct BufferView
+  {
+    size_t size() const
+    {
+      return buffer.size();
+    }
+
+    int64_t stamp(size_t n) const
+    {
+      return stampOf<i>(buffer[n]);
+    }
+
+    const typename std::tuple_element<i, Events>::type & event(size_t n) const
+    {
+      return buffer[n];
+    }
+
+    void pop_front()
+    {
+      buffer.pop_front();
+    }
+
+    RingBuffer<typename std::tuple_element<i, Events>::type> & buffer;
+  };
+
+  // Calls <f> with a Cursor or a BufferView on the messages of input i
+  // assumes mutex_ is already locked
+  template<int i, class F>
+  auto withMessages(F f)
+  {
+    auto & cursor = std::get<i>(cursors_);
+    if (cursor.attached()) {
+      auto lock = cursor.lock();
+      return f(cursor);
+    }
+    BufferView<i> view{std::get<i>(buffers_)};
+    return f(view);
+  }
+
+  // assumes mutex_ is already locked
+  RingBuffer<M0Event> & pivots()
+  {
+    return std::get<0>(buffers_);
+  }
+
+  template<int i>
+  static int64_t stampOf(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    namespace mt = message_filters::message_traits;
+    return mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(
+      *evt.getMessage()).nanoseconds();
+  }
+
+  // Signals the pivot messages whose neighbors are all known
+  // assumes mutex_ is already locked
+  void process()
+  {
+    while (!pivots().empty() &&
+      hasLaterNeighbors(stampOf<0>(pivots().front()), std::make_index_sequence<9u>()))
+    {
+      signalPivot();
+    }
+  }
+
+  template<size_t ... Is>
+  bool hasLaterNeighbors(int64_t stamp, std::index_sequence<Is...> const &)
+  {
+    return (hasLaterNeighbor<Is>(stamp) && ...);
+  }
+
+  // assumes mutex_ is already locked
+  template<int i>
+  bool hasLaterNeighbor(int64_t stamp)
+  {
+    if (i == 0 || i >= RealTypeCount::value) {
+      return true;
+    }
+    return withMessages<i>(
+      [stamp](auto & messages) {
+        return messages.size() > 0 && messages.stamp(messages.size() - 1) >= stamp;
+      });
+  }
+
+  // Pairs the oldest pivot message with the nearest messages of the other inputs, and signals
+  // the tuple, or drops it if it is incomplete
+  // assumes mutex_ is already locked
+  void signalPivot()
+  {
+    Tuple t;
+    std::get<0>(t) = pivots().front();
+    pivots().pop_front();
+    if (findNearest(stampOf<0>(std::get<0>(t)), t, std::make_index_sequence<9u>())) {
+      parent_->enqueueSignal(
+        std::get<0>(t), std::get<1>(t), std::get<2>(t),
+        std::get<3>(t), std::get<4>(t), std::get<5>(t),
+        std::get<6>(t), std::get<7>(t), std::get<8>(t));
+    } else {
+      parent_->enqueueDrop(
+        drop_signal_,
+        std::get<0>(t), std::get<1>(t), std::get<2>(t),
+        std::get<3>(t), std::get<4>(t), std::get<5>(t),
+        std::get<6>(t), std::get<7>(t), std::get<8>(t));
+    }
+  }
+
+  template<size_t ... Is>
+  bool findNearest(int64_t stamp, Tuple & t, std::index_sequence<Is...> const &)
+  {
+    // Not short-circuited, so that every buffer is trimmed
+    bool complete = true;
+    ((complete &= findNearest<Is>(stamp, t)), ...);
+    return complete;
+  }
+
+  // Sets the i-th event of <t> to the message nearest to <stamp> if it is within the tolerance,
+  // and discards the messages that no later pivot message can be paired with
+  // assumes mutex_ is already locked
+  template<int i>
+  bool findNearest(int64_t stamp, Tuple & t)
+  {
+    if (i == 0 || i >= RealTypeCount::value) {
+      return true;
+    }
+    return withMessages<i>(
+      [this, stamp, &t](auto & messages) {
+        if (messages.size() == 0) {
+          return false;
+        }
+
+        // The first message stamped at or after <stamp>
+        size_t low = 0;
+        size_t high = messages.size();
+        while (low < high) {
+          size_t mid = low + (high - low) / 2;
+          if (messages.stamp(mid) < stamp) {
+            low = mid + 1;
+          } else {
+            high = mid;
+          }
+        }
+
+        size_t nearest = low;
+        if (low == messages.size() ||
+          (low > 0 && stamp - messages.stamp(low - 1) <= messages.stamp(low) - stamp))
+        {
+          nearest = low - 1;
+        }
+        int64_t distance = messages.stamp(nearest) - stamp;
+        bool found = (distance < 0 ? -distance : distance) <= tolerance_;
+        if (found) {
+          std::get<i>(t) = messages.event(nearest);
+        }
+
+        // Later pivot messages are not older, so their nearest message is at least the one
+        // before <low>
+        for (size_t n = 1; n < low; ++n) {
+          messages.pop_front();
+        }
+        return found;
+      });
+  }
+
+  Sync * parent_;
+
+  uint32_t queue_size_;
+  int64_t tolerance_;  // Nanoseconds
+
+  Buffers buffers_;
+  Cursors cursors_;
+
+  Signal drop_signal_;
+
+  std::mutex mutex_;
+};
+
+}  // namespace sync_policies
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__SYNC_POLICIES__NEAREST_TIME_HPP_
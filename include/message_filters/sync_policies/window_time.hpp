@@ -0,0 +1,550 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__SYNC_POLICIES__WINDOW_TIME_HPP_
+#define MESSAGE_FILTERS__SYNC_POLICIES__WINDOW_TIME_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+
+#include "message_filters/connection.hpp"
+#include "message_filters/message_traits.hpp"
+#include "message_filters/null_types.hpp"
+#include "message_filters/ring_buffer.hpp"
+#include "message_filters/synchronizer.hpp"
+
+namespace message_filters
+{
+namespace sync_policies
+{
+
+/**
+ * \brief A contiguous, read only range of events, sorted by stamp.
+ *
+ * The range shares the ownership of the storage it points into, so it stays valid, and is never
+ * modified, for as long as it is kept, whatever the policy that produced it does in the meantime.
+ */
+template<class E>
+class EventRange
+{
+public:
+  typedef const E * const_iterator;
+
+  EventRange()
+  : begin_(nullptr)
+    , end_(nullptr)
+  {
+  }
+
+  EventRange(std::shared_ptr<const void> owner, const E * begin, const E * end)
+  : owner_(std::move(owner))
+    , begin_(begin)
+    , end_(end)
+  {
+  }
+
+  const_iterator begin() const
+  {
+    return begin_;
+  }
+
+  const_iterator end() const
+  {
+    return end_;
+  }
+
+  size_t size() const
+  {
+    return static_cast<size_t>(end_ - begin_);
+  }
+
+  bool empty() const
+  {
+    return begin_ == end_;
+  }
+
+  const E & operator[](size_t n) const
+  {
+    assert(n < size());
+    return begin_[n];
+  }
+
+  const E & front() const
+  {
+    assert(!empty());
+    return *begin_;
+  }
+
+  const E & back() const
+  {
+    assert(!empty());
+    return *(end_ - 1);
+  }
+
+private:
+  std::shared_ptr<const void> owner_;
+  const E * begin_;
+  const E * end_;
+};
+
+/**
+ * \brief Joins every message of the first input, the pivot, with all the messages of each of the
+ * other inputs that fall in a time window around it.
+ *
+ * By default the window of a pivot message stamped t covers the stamps in (p, t], where p is the
+ * stamp of the previous pivot message: every secondary message is then part of exactly one
+ * window, as needed to integrate IMU measurements between camera frames. With setWindow(), it
+ * covers [t - before, t + after] instead, and windows may overlap.
+ *
+ * The windows are not delivered through the callbacks registered with registerCallback(), which
+ * only carry one message per input, but as a Window tuple to the callbacks registered with
+ * registerWindowCallback(). A pivot message is delivered once every other input has received a
+ * message stamped after the end of its window, so that the window is complete, or once more than
+ * queue_size pivot messages are waiting for a stalled input.
+ *
+ * The ranges of a window point straight into the buffers of the policy, without copying the
+ * events. A buffer is an array that is only ever appended to; the messages that no future
+ * window can cover are skipped at once, and their storage is released when the buffer is full
+ * and its remaining messages are moved to a new one, which no longer happens once every window
+ * pointing into the old one has been destroyed. The secondary messages must arrive in stamp
+ * order: those older than the newest one already received are dropped, see getLateDropCount().
+ */
+template<typename M0, typename M1, typename M2 = NullType, typename M3 = NullType,
+  typename M4 = NullType, typename M5 = NullType, typename M6 = NullType,
+  typename M7 = NullType, typename M8 = NullType>
+struct WindowTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
+{
+  typedef Synchronizer<WindowTime> Sync;
+  typedef PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8> Super;
+  typedef typename Super::Messages Messages;
+  typedef typename Super::Signal Signal;
+  typedef typename Super::Events Events;
+  typedef typename Super::RealTypeCount RealTypeCount;
+  typedef typename Super::M0Event M0Event;
+  typedef typename Super::M1Event M1Event;
+  typedef typename Super::M2Event M2Event;
+  typedef typename Super::M3Event M3Event;
+  typedef typename Super::M4Event M4Event;
+  typedef typename Super::M5Event M5Event;
+  typedef typename Super::M6Event M6Event;
+  typedef typename Super::M7Event M7Event;
+  typedef typename Super::M8Event M8Event;
+  typedef std::tuple<M0Event, EventRange<M1Event>, EventRange<M2Event>, EventRange<M3Event>,
+      EventRange<M4Event>, EventRange<M5Event>, EventRange<M6Event>, EventRange<M7Event>,
+      EventRange<M8Event>> Window;
+  typedef std::function<void(const Window &)> WindowCallback;
+
+  /**
+   * \param queue_size The maximum number of messages kept per input, 0 for unbounded. The
+   *        oldest secondary messages are dropped beyond it, so it should hold at least a window.
+   */
+  WindowTime(uint32_t queue_size)  // NOLINT(runtime/explicit)
+  : parent_(0)
+    , queue_size_(queue_size)
+    , before_(0)
+    , after_(0)
+    , since_previous_pivot_(true)
+    , previous_pivot_stamp_(std::numeric_limits<int64_t>::min())
+    , late_drops_(0)
+  {
+  }
+
+  WindowTime(const WindowTime & e)
+  {
+    *this = e;
+  }
+
+  WindowTime & operator=(const WindowTime & rhs)
+  {
+    parent_ = rhs.parent_;
+    queue_size_ = rhs.queue_size_;
+    before_ = rhs.before_;
+    after_ = rhs.after_;
+    since_previous_pivot_ = rhs.since_previous_pivot_;
+    previous_pivot_stamp_ = rhs.previous_pivot_stamp_;
+    late_drops_ = rhs.late_drops_;
+    pivots_ = rhs.pivots_;
+    buffers_ = rhs.buffers_;
+
+    return *this;
+  }
+
+  void initParent(Sync * parent)
+  {
+    parent_ = parent;
+  }
+
+  /**
+   * \brief Make the window of a pivot message stamped t cover [t - \p before, t + \p after]
+   * instead of the time since the previous pivot message.
+   *
+   * Must be called before any message is received.
+   */
+  void setWindow(const rclcpp::Duration & before, const rclcpp::Duration & after)
+  {
+    assert(before >= rclcpp::Duration(0, 0) && after >= rclcpp::Duration(0, 0));
+    std::lock_guard<std::mutex> lock(mutex_);
+    before_ = before.nanoseconds();
+    after_ = after.nanoseconds();
+    since_previous_pivot_ = false;
+  }
+
+  /**
+   * \brief Register a callback to be called with the window of each pivot message.
+   */
+  Connection registerWindowCallback(const WindowCallback & callback)
+  {
+    auto helper = std::make_shared<WindowCallback>(callback);
+    {
+      std::lock_guard<std::mutex> lock(window_callbacks_mutex_);
+      window_callbacks_.push_back(helper);
+    }
+    return Connection(
+      [this, helper]() {
+        std::lock_guard<std::mutex> lock(window_callbacks_mutex_);
+        auto it = std::find(window_callbacks_.begin(), window_callbacks_.end(), helper);
+        if (it != window_callbacks_.end()) {
+          window_callbacks_.erase(it);
+        }
+      });
+  }
+
+  /**
+   * \brief The number of secondary messages dropped because they arrived out of order.
+   */
+  uint64_t getLateDropCount()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return late_drops_;
+  }
+
+  template<int i>
+  void add(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    assert(parent_);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    int64_t stamp = stampOf<i>(evt);
+    if constexpr (i == 0) {
+      pivots_.push_back(evt);
+      // Move it back to its place if it arrived out of order
+      for (size_t n = pivots_.size() - 1; n > 0 && stamp < stampOf<0>(pivots_[n - 1]); --n) {
+        std::swap(pivots_[n], pivots_[n - 1]);
+      }
+    } else {
+      auto & buffer = std::get<i>(buffers_);
+      if (!buffer.push(evt, stamp)) {
+        ++late_drops_;
+      } else if (queue_size_ > 0 && buffer.size() > queue_size_) {
+        buffer.pop_front();
+      }
+    }
+    process();
+    lock.unlock();
+
+    // Deliver the windows, if any, now that other inputs can be added again
+    dispatch();
+  }
+
+private:
+  // The messages of a secondary input, sorted by stamp, in an array that is only appended to
+  template<class E>
+  class Buffer
+  {
+public:
+    Buffer() = default;
+
+    Buffer(const Buffer & other)
+    {
+      *this = other;
+    }
+
+    // The copy gets its own storage, since the storage is appended to
+    Buffer & operator=(const Buffer & rhs)
+    {
+      if (this != &rhs) {
+        events_.reset();
+        stamps_.clear();
+        head_ = 0;
+        newest_stamp_ = rhs.newest_stamp_;
+        if (rhs.size() > 0) {
+          moveTo(rhs, rhs.events_->capacity());
+        }
+      }
+      return *this;
+    }
+
+    // Returns false, without adding it, if <evt> is older than the newest message
+    bool push(const E & evt, int64_t stamp)
+    {
+      if (stamp < newest_stamp_) {
+        return false;
+      }
+      newest_stamp_ = stamp;
+      if (!events_ || events_->size() == events_->capacity()) {
+        // Move the messages still in use to a new array, leaving the old one to the windows
+        // that point into it
+        moveTo(*this, std::max<size_t>(16, 2 * (size() + 1)));
+      }
+      events_->push_back(evt);
+      stamps_.push_back(stamp);
+      return true;
+    }
+
+    size_t size() const
+    {
+      return stamps_.size() - head_;
+    }
+
+    int64_t newestStamp() const
+    {
+      return newest_stamp_;
+    }
+
+    void pop_front()
+    {
+      skipTo(head_ + 1);
+    }
+
+    // The position of the first message stamped at or after <stamp>
+    size_t lowerBound(int64_t stamp) const
+    {
+      return std::lower_bound(stamps_.begin() + head_, stamps_.end(), stamp) - stamps_.begin();
+    }
+
+    // The position of the first message stamped after <stamp>
+    size_t upperBound(int64_t stamp) const
+    {
+      return std::upper_bound(stamps_.begin() + head_, stamps_.end(), stamp) - stamps_.begin();
+    }
+
+    EventRange<E> range(size_t begin, size_t end) const
+    {
+      if (begin >= end) {
+        return EventRange<E>();
+      }
+      const E * data = events_->data();
+      return EventRange<E>(events_, data + begin, data + end);
+    }
+
+    // Forgets the messages before position <n>
+    void skipTo(size_t n)
+    {
+      head_ = std::max(head_, n);
+      if (head_ < stamps_.size()) {
+        return;
+      }
+      // Nothing is left: reuse the array right away if no window points into it
+      if (events_ && events_.use_count() == 1) {
+        events_->clear();
+      } else {
+        events_.reset();
+      }
+      stamps_.clear();
+      head_ = 0;
+    }
+
+private:
+    void moveTo(const Buffer & from, size_t capacity)
+    {
+      auto events = std::make_shared<std::vector<E>>();
+      events->reserve(capacity);
+      std::vector<int64_t> stamps;
+      stamps.reserve(capacity);
+      if (from.events_) {
+        events->assign(from.events_->begin() + from.head_, from.events_->end());
+        stamps.assign(from.stamps_.begin() + from.head_, from.stamps_.end());
+      }
+      events_ = std::move(events);
+      stamps_ = std::move(stamps);
+      head_ = 0;
+    }
+
+    std::shared_ptr<std::vector<E>> events_;
+    std::vector<int64_t> stamps_;  // The stamps of events_
+    size_t head_{0};  // The position of the oldest message still in use
+    int64_t newest_stamp_{std::numeric_limits<int64_t>::min()};
+  };
+
+  typedef std::tuple<Buffer<M0Event>, Buffer<M1Event>, Buffer<M2Event>, Buffer<M3Event>,
+      Buffer<M4Event>, Buffer<M5Event>, Buffer<M6Event>, Buffer<M7Event>,
+      Buffer<M8Event>> Buffers;
+
+  template<int i>
+  static int64_t stampOf(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    namespace mt = message_filters::message_traits;
+    return mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(
+      *evt.getMessage()).nanoseconds();
+  }
+
+  // The last stamp covered by the window of a pivot message stamped <stamp>
+  int64_t windowEnd(int64_t stamp) const
+  {
+    if (since_previous_pivot_ || stamp > std::numeric_limits<int64_t>::max() - after_) {
+      return stamp;
+    }
+    return stamp + after_;
+  }
+
+  // Closes the windows that are complete
+  // assumes mutex_ is already locked
+  void process()
+  {
+    while (!pivots_.empty()) {
+      int64_t end = windowEnd(stampOf<0>(pivots_.front()));
+      bool stalled = queue_size_ > 0 && pivots_.size() > queue_size_;
+      if (!stalled && !isComplete(end, std::make_index_sequence<9u>())) {
+        break;
+      }
+      closeWindow();
+    }
+  }
+
+  template<size_t ... Is>
+  bool isComplete(int64_t end, std::index_sequence<Is...> const &) const
+  {
+    return (isComplete<Is>(end) && ...);
+  }
+
+  template<int i>
+  bool isComplete(int64_t end) const
+  {
+    if constexpr (i == 0 || i >= RealTypeCount::value) {
+      return true;
+    } else {
+      return std::get<i>(buffers_).newestStamp() > end;
+    }
+  }
+
+  // Delivers the window of the oldest pivot message, then forgets the messages that the windows
+  // of the later pivot messages, which are not older, cannot cover
+  // assumes mutex_ is already locked
+  void closeWindow()
+  {
+    Window window;
+    std::get<0>(window) = pivots_.front();
+    pivots_.pop_front();
+    int64_t stamp = stampOf<0>(std::get<0>(window));
+    fillWindow(stamp, window, std::make_index_sequence<9u>());
+    previous_pivot_stamp_ = std::max(previous_pivot_stamp_, stamp);
+    pending_.push_back(std::move(window));
+  }
+
+  template<size_t ... Is>
+  void fillWindow(int64_t stamp, Window & window, std::index_sequence<Is...> const &)
+  {
+    (fillWindow<Is>(stamp, window), ...);
+  }
+
+  template<int i>
+  void fillWindow(int64_t stamp, Window & window)
+  {
+    if constexpr (i > 0 && i < RealTypeCount::value) {
+      auto & buffer = std::get<i>(buffers_);
+      size_t end = buffer.upperBound(windowEnd(stamp));
+      if (since_previous_pivot_) {
+        size_t begin = buffer.upperBound(previous_pivot_stamp_);
+        std::get<i>(window) = buffer.range(begin, end);
+        buffer.skipTo(end);
+      } else {
+        int64_t start = stamp < std::numeric_limits<int64_t>::min() + before_ ?
+          std::numeric_limits<int64_t>::min() : stamp - before_;
+        size_t begin = buffer.lowerBound(start);
+        std::get<i>(window) = buffer.range(begin, end);
+        buffer.skipTo(begin);
+      }
+    }
+  }
+
+  // Delivers the pending windows in order. If another thread is already delivering, that thread
+  // also delivers the ones closed so far, so that the callbacks are never run concurrently or
+  // out of order.
+  void dispatch()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (dispatching_) {
+      return;
+    }
+    dispatching_ = true;
+    while (!pending_.empty()) {
+      Window window = std::move(pending_.front());
+      pending_.pop_front();
+      lock.unlock();
+      try {
+        std::lock_guard<std::mutex> callbacks_lock(window_callbacks_mutex_);
+        for (const auto & callback : window_callbacks_) {
+          (*callback)(window);
+        }
+      } catch (...) {
+        lock.lock();
+        dispatching_ = false;
+        throw;
+      }
+      lock.lock();
+    }
+    dispatching_ = false;
+  }
+
+  Sync * parent_;
+
+  uint32_t queue_size_;
+  int64_t before_;  // Nanoseconds
+  int64_t after_;  // Nanoseconds
+  bool since_previous_pivot_;
+
+  // Everything below is protected by mutex_
+  int64_t previous_pivot_stamp_;
+  uint64_t late_drops_;
+  RingBuffer<M0Event> pivots_;  // The pivot messages whose window is not closed, sorted by stamp
+  Buffers buffers_;
+  RingBuffer<Window> pending_;  // The windows closed and not yet delivered
+  bool dispatching_{false};
+
+  std::mutex mutex_;
+
+  std::vector<std::shared_ptr<WindowCallback>> window_callbacks_;
+  std::mutex window_callbacks_mutex_;  // Protects window_callbacks_
+};
+
+}  // namespace sync_policies
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__SYNC_POLICIES__WINDOW_TIME_HPP_
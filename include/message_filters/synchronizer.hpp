@@ -29,22 +29,61 @@
 #ifndef MESSAGE_FILTERS__SYNCHRONIZER_HPP_
 #define MESSAGE_FILTERS__SYNCHRONIZER_HPP_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
 #include <deque>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "message_filters/connection.hpp"
+#include "message_filters/lock_free_queue.hpp"
 #include "message_filters/null_types.hpp"
 #include "message_filters/message_event.hpp"
+#include "message_filters/message_traits.hpp"
 #include "message_filters/signal9.hpp"
+#include "message_filters/sync_group.hpp"
 
 namespace message_filters
 {
 
+/**
+ * \brief What a Synchronizer does with a newly matched tuple when as many tuples as its output
+ * limit are already waiting for the callbacks, see Synchronizer::enableOutputLimit().
+ */
+enum class OutputOverflow
+{
+  DropOldest,  // Discard the oldest waiting tuple
+  KeepLatest,  // Discard all the waiting tuples, so that the new one is delivered next
+  Block  // Make the thread that matched the tuple wait until the callbacks have caught up
+};
+
+/**
+ * \brief How long the callbacks of a Synchronizer took to run, see
+ * Synchronizer::getCallbackStats().
+ */
+struct CallbackStats
+{
+  uint64_t calls{0};  // Number of tuples, or batches, delivered
+  std::chrono::nanoseconds total{0};
+  std::chrono::nanoseconds max{0};
+  std::chrono::nanoseconds last{0};
+};
+
 template<class Policy>
 class Synchronizer : public noncopyable, public Policy
 {
@@ -213,6 +252,10 @@ public:
   ~Synchronizer()
   {
     disconnectAll();
+    stopIngestion();
+    if (group_) {
+      group_->leave(group_member_);
+    }
   }
 
   void init()
@@ -330,6 +373,217 @@ public:
   void setName(const std::string & name) {name_ = name;}
   const std::string & getName() {return name_;}
 
+  /**
+   * \brief Also push every matched tuple into a bounded queue, for a thread that polls for them
+   * with tryPop() or latest() instead of being called back.
+   *
+   * The queue is lock-free and its storage is allocated here, so polling it never blocks or
+   * allocates. When it is full, the oldest tuple is discarded to make room, see
+   * getOutputQueueDropCount(). The registered callbacks are still called.
+   *
+   * Must be called before any message is received.
+   *
+   * \param queue_size The capacity of the queue, rounded up to a power of two.
+   */
+  void enableOutputQueue(uint32_t queue_size)
+  {
+    output_queue_ = std::make_unique<LockFreeQueue<Events>>(queue_size);
+  }
+
+  /**
+   * \brief Move the oldest tuple of the output queue into \p events.
+   * \return false if the queue was empty, in which case \p events is untouched
+   */
+  bool tryPop(Events & events)
+  {
+    assert(output_queue_);
+    return output_queue_->tryPop(events);
+  }
+
+  /**
+   * \brief Move the newest tuple of the output queue into \p events, discarding the older ones.
+   * \return false if the queue was empty, in which case \p events is untouched
+   */
+  bool latest(Events & events)
+  {
+    assert(output_queue_);
+    if (!output_queue_->tryPop(events)) {
+      return false;
+    }
+    while (output_queue_->tryPop(events)) {
+      // Keep the newer one
+    }
+    return true;
+  }
+
+  /**
+   * \brief The number of tuples discarded because the output queue was full.
+   */
+  uint64_t getOutputQueueDropCount() const
+  {
+    return output_queue_drops_.load(std::memory_order_relaxed);
+  }
+
+  typedef std::vector<Events> Batch;
+  typedef std::function<void(const Batch &)> BatchCallback;
+
+  /**
+   * \brief Deliver the matched tuples in batches instead of one at a time.
+   *
+   * Once enabled, matched tuples are no longer passed to the callbacks registered with
+   * registerCallback(). They are collected, in the order they were matched, and passed as one
+   * vector to the callbacks registered with registerBatchCallback(). A batch is delivered as soon
+   * as it holds \p max_size tuples, or when a tuple is matched whose first message is stamped at
+   * least \p window after that of the oldest tuple of the batch; that tuple then starts the next
+   * batch. Use flushBatch() to deliver an incomplete batch.
+   *
+   * Must be called before any message is received.
+   *
+   * \param max_size The maximum number of tuples per batch, 0 for no limit
+   * \param window The maximum time span of a batch, measured on the stamps of the first input
+   */
+  void enableBatching(size_t max_size, rclcpp::Duration window = rclcpp::Duration::max())
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    batching_ = true;
+    batch_max_size_ = max_size;
+    batch_window_ = window < rclcpp::Duration::max() ?
+      window.nanoseconds() : std::numeric_limits<int64_t>::max();
+  }
+
+  /**
+   * \brief Register a callback to be called with each batch, see enableBatching().
+   */
+  Connection registerBatchCallback(const BatchCallback & callback)
+  {
+    auto helper = std::make_shared<BatchCallback>(callback);
+    {
+      std::lock_guard<std::mutex> lock(batch_callbacks_mutex_);
+      batch_callbacks_.push_back(helper);
+    }
+    return Connection(
+      [this, helper]() {
+        std::lock_guard<std::mutex> lock(batch_callbacks_mutex_);
+        auto it = std::find(batch_callbacks_.begin(), batch_callbacks_.end(), helper);
+        if (it != batch_callbacks_.end()) {
+          batch_callbacks_.erase(it);
+        }
+      });
+  }
+
+  /**
+   * \brief Deliver the tuples collected so far as a batch, even if it is not complete.
+   */
+  void flushBatch()
+  {
+    {
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      collectBatches();
+      if (!batch_.empty()) {
+        completeBatch();
+      }
+    }
+    dispatchSignals();
+  }
+
+  /**
+   * \brief Bound the number of matched tuples waiting for the registered callbacks.
+   *
+   * Tuples are matched on the input threads but delivered by one thread at a time, so callbacks
+   * slower than the inputs make the tuples waiting for them, and their latency, grow without
+   * bound. With a limit, once \p max_pending tuples are waiting, a newly matched tuple is handled
+   * according to \p overflow. Discarded tuples are not delivered, and are counted by
+   * getShedCount(). When blocking, the thread that matched the tuple waits, after releasing the
+   * policy lock, until at most \p max_pending tuples are left; the waiting tuples may therefore
+   * exceed the limit by one per input thread. A callback adding messages to this synchronizer is
+   * never blocked.
+   *
+   * With batching enabled, only the tuples not yet collected into a batch are counted.
+   *
+   * \param max_pending The maximum number of waiting tuples, 0 for no limit
+   * \param overflow What to do with a tuple matched while the limit is reached
+   */
+  void enableOutputLimit(size_t max_pending, OutputOverflow overflow)
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    output_limit_ = max_pending;
+    output_overflow_ = overflow;
+    pending_space_.notify_all();
+  }
+
+  /**
+   * \brief The number of matched tuples discarded because of the output limit.
+   */
+  uint64_t getShedCount()
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    return shed_count_;
+  }
+
+  /**
+   * \brief How long the registered callbacks, or batch callbacks, took for each delivery so far.
+   */
+  CallbackStats getCallbackStats()
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    return callback_stats_;
+  }
+
+  /**
+   * \brief Buffer the connected inputs in lock-free queues instead of adding to the policy
+   * directly from each input callback.
+   *
+   * Each input pushes its messages into its own bounded queue and returns without waiting for
+   * the policy. A matcher thread started here drains the queues, feeding the queued messages to
+   * the policy in timestamp order (ties go to the lowest input index), so input threads never run
+   * the policy or the registered callbacks, which run on the matcher thread and must not throw.
+   *
+   * The order only covers the messages queued when the matcher looks for the oldest one: a
+   * message received after an older message of another input has been fed to the policy is fed
+   * after it. Results are therefore independent of the order in which messages of different
+   * inputs were received only while the matcher runs behind the inputs.
+   *
+   * A message that arrives while its queue is full is dropped and counted, see
+   * getIngestionDropCount(). Messages passed to add() directly bypass the queues.
+   *
+   * Must be called once, before any message is received.
+   *
+   * \param queue_size The capacity of each input queue, rounded up to a power of two.
+   */
+  void enableIngestionQueues(uint32_t queue_size)
+  {
+    auto size = [queue_size](int i) -> size_t {
+        return i < RealTypeCount::value ? queue_size : 1;
+      };
+    ingestion_queues_ = std::make_unique<IngestionQueues>(
+      size(0), size(1), size(2), size(3), size(4), size(5), size(6), size(7), size(8));
+    ingestion_thread_ = std::thread(&Synchronizer::runIngestion, this);
+  }
+
+  /**
+   * \brief The number of messages of input \p i dropped because its ingestion queue was full.
+   */
+  uint64_t getIngestionDropCount(uint32_t i) const
+  {
+    return ingestion_drops_.at(i).load(std::memory_order_relaxed);
+  }
+
+
+  /**
+   * \brief Run this synchronizer on a worker of \p group instead of on the input threads.
+   *
+   * The connected inputs then only post their messages to the group and return. The policy and
+   * the registered callbacks run on the worker this synchronizer is assigned to, in the order the
+   * messages were received, so the policy lock is never contended. This takes precedence over
+   * enableIngestionQueues(). Messages passed to add() directly still run on the calling thread.
+   *
+   * Must be called before any message is received. \p group must outlive this synchronizer.
+   */
+  void joinGroup(SyncGroup & group)
+  {
+    group_ = &group;
+    group_member_ = group.join();
+  }
 
   void signal(
     const M0Event & e0, const M1Event & e1, const M2Event & e2, const M3Event & e3,
@@ -339,6 +593,115 @@ public:
     signal_.call(e0, e1, e2, e3, e4, e5, e6, e7, e8);
   }
 
+  /**
+   * \brief Queue a matched tuple, to be delivered by the next call to dispatchSignals().
+   *
+   * Policies call this while holding their own lock, so that the registered callbacks can run
+   * once that lock has been released instead of blocking every other input.
+   */
+  void enqueueSignal(
+    const M0Event & e0, const M1Event & e1, const M2Event & e2, const M3Event & e3,
+    const M4Event & e4, const M5Event & e5, const M6Event & e6, const M7Event & e7,
+    const M8Event & e8)
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    if (output_limit_ > 0 && pending_.size() >= output_limit_) {
+      if (output_overflow_ == OutputOverflow::DropOldest) {
+        shed_count_ += pending_.size() - output_limit_ + 1;
+        pending_.erase(pending_.begin(), pending_.end() - (output_limit_ - 1));
+      } else if (output_overflow_ == OutputOverflow::KeepLatest) {
+        shed_count_ += pending_.size();
+        pending_.clear();
+      }
+    }
+    pending_.emplace_back(e0, e1, e2, e3, e4, e5, e6, e7, e8);
+    ++queued_count_;
+    if (output_queue_) {
+      // pending_mutex_ makes this the only producer
+      while (!output_queue_->tryPush(pending_.back())) {
+        Events oldest;
+        if (output_queue_->tryPop(oldest)) {
+          output_queue_drops_.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+
+  /**
+   * \brief Queue a call of \p drop_signal with a tuple the policy dropped, to be made by the next
+   * call to dispatchSignals() once the tuples queued before it have been delivered.
+   *
+   * Like enqueueSignal(), policies call this while holding their own lock, so that drop callbacks
+   * also run outside of it, and in order with the matched tuples. Drops are neither limited by
+   * enableOutputLimit() nor put in the output queue. With batching enabled, a drop is reported
+   * once the tuples queued before it have been collected into a batch, which may be before that
+   * batch is delivered.
+   */
+  void enqueueDrop(
+    Signal & drop_signal,
+    const M0Event & e0, const M1Event & e1, const M2Event & e2, const M3Event & e3,
+    const M4Event & e4, const M5Event & e5, const M6Event & e6, const M7Event & e7,
+    const M8Event & e8)
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_drops_.push_back(
+      PendingDrop{Events(e0, e1, e2, e3, e4, e5, e6, e7, e8), &drop_signal, queued_count_});
+  }
+
+  /**
+   * \brief Deliver the tuples queued by enqueueSignal() and the drops queued by enqueueDrop(),
+   * in the order they were queued.
+   *
+   * Must be called without holding the policy lock. If another thread is already delivering
+   * tuples, that thread also delivers the ones queued so far and this call returns immediately,
+   * so the callbacks are never run concurrently or out of order. With an output limit set to
+   * OutputOverflow::Block, it first waits for that thread to catch up, see enableOutputLimit().
+   */
+  void dispatchSignals()
+  {
+    std::unique_lock<std::mutex> lock(pending_mutex_);
+    if (dispatching_ && output_limit_ > 0 && output_overflow_ == OutputOverflow::Block &&
+      dispatcher_ != std::this_thread::get_id())
+    {
+      pending_space_.wait(
+        lock, [this]() {
+          return !dispatching_ || output_limit_ == 0 || pending_.size() <= output_limit_;
+        });
+    }
+    if (dispatching_) {
+      return;
+    }
+    dispatching_ = true;
+    dispatcher_ = std::this_thread::get_id();
+    if (batching_) {
+      dispatchBatches(lock);
+      return;
+    }
+    dispatchDrops(lock);
+    while (!pending_.empty()) {
+      Events events = std::move(pending_.front());
+      pending_.pop_front();
+      pending_space_.notify_all();
+      lock.unlock();
+      auto start = std::chrono::steady_clock::now();
+      try {
+        signal_.call(
+          std::get<0>(events), std::get<1>(events), std::get<2>(events),
+          std::get<3>(events), std::get<4>(events), std::get<5>(events),
+          std::get<6>(events), std::get<7>(events), std::get<8>(events));
+      } catch (...) {
+        lock.lock();
+        stopDispatching();
+        throw;
+      }
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      lock.lock();
+      recordCallbackTime(elapsed);
+      dispatchDrops(lock);
+    }
+    stopDispatching();
+  }
+
   Policy * getPolicy() {return static_cast<Policy *>(this);}
 
   using Policy::add;
@@ -357,10 +720,264 @@ private:
     }
   }
 
+  // assumes pending_mutex_ is locked through <lock> and dispatching_ is set
+  void dispatchBatches(std::unique_lock<std::mutex> & lock)
+  {
+    collectBatches();
+    dispatchDrops(lock);
+    while (!ready_batches_.empty()) {
+      Batch batch = std::move(ready_batches_.front());
+      ready_batches_.pop_front();
+      lock.unlock();
+      auto start = std::chrono::steady_clock::now();
+      try {
+        std::lock_guard<std::mutex> callbacks_lock(batch_callbacks_mutex_);
+        for (const auto & callback : batch_callbacks_) {
+          (*callback)(batch);
+        }
+      } catch (...) {
+        lock.lock();
+        stopDispatching();
+        throw;
+      }
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      lock.lock();
+      recordCallbackTime(elapsed);
+      collectBatches();
+      dispatchDrops(lock);
+    }
+    stopDispatching();
+  }
+
+  // Calls the drop signals of the queued drops whose preceding tuples have all left pending_
+  // assumes pending_mutex_ is locked through <lock> and dispatching_ is set
+  void dispatchDrops(std::unique_lock<std::mutex> & lock)
+  {
+    while (!pending_drops_.empty() &&
+      pending_drops_.front().after <= queued_count_ - pending_.size())
+    {
+      PendingDrop drop = std::move(pending_drops_.front());
+      pending_drops_.pop_front();
+      lock.unlock();
+      try {
+        drop.signal->call(
+          std::get<0>(drop.events), std::get<1>(drop.events), std::get<2>(drop.events),
+          std::get<3>(drop.events), std::get<4>(drop.events), std::get<5>(drop.events),
+          std::get<6>(drop.events), std::get<7>(drop.events), std::get<8>(drop.events));
+      } catch (...) {
+        lock.lock();
+        stopDispatching();
+        throw;
+      }
+      lock.lock();
+    }
+  }
+
+  // assumes pending_mutex_ is already locked
+  void stopDispatching()
+  {
+    dispatching_ = false;
+    dispatcher_ = std::thread::id();
+    // Producers blocked by the output limit can now deliver their tuples themselves
+    pending_space_.notify_all();
+  }
+
+  // assumes pending_mutex_ is already locked
+  void recordCallbackTime(std::chrono::nanoseconds elapsed)
+  {
+    ++callback_stats_.calls;
+    callback_stats_.total += elapsed;
+    callback_stats_.max = std::max(callback_stats_.max, elapsed);
+    callback_stats_.last = elapsed;
+  }
+
+  // Moves the pending tuples to the current batch, completing it whenever it is full
+  // assumes pending_mutex_ is already locked
+  void collectBatches()
+  {
+    namespace mt = message_filters::message_traits;
+
+    while (!pending_.empty()) {
+      if (batch_window_ != std::numeric_limits<int64_t>::max()) {
+        int64_t stamp = mt::TimeStamp<M0>::value(
+          *std::get<0>(pending_.front()).getMessage()).nanoseconds();
+        if (!batch_.empty() && stamp - batch_start_ >= batch_window_) {
+          completeBatch();
+        }
+        if (batch_.empty()) {
+          batch_start_ = stamp;
+        }
+      }
+      batch_.push_back(std::move(pending_.front()));
+      pending_.pop_front();
+      if (batch_max_size_ != 0 && batch_.size() >= batch_max_size_) {
+        completeBatch();
+      }
+    }
+  }
+
+  // assumes pending_mutex_ is already locked
+  void completeBatch()
+  {
+    ready_batches_.push_back(std::move(batch_));
+    batch_ = Batch();
+    batch_.reserve(batch_max_size_);
+  }
+
   template<int i>
   void cb(const typename std::tuple_element<i, Events>::type & evt)
   {
-    this->template add<i>(evt);
+    if (group_) {
+      group_->post(group_member_, [this, evt]() {this->template add<i>(evt);});
+    } else if (ingestion_queues_) {
+      ingest<i>(evt);
+    } else {
+      this->template add<i>(evt);
+    }
+  }
+
+  typedef typename Policy::RealTypeCount RealTypeCount;
+  typedef std::tuple<LockFreeQueue<M0Event>, LockFreeQueue<M1Event>, LockFreeQueue<M2Event>,
+      LockFreeQueue<M3Event>, LockFreeQueue<M4Event>, LockFreeQueue<M5Event>,
+      LockFreeQueue<M6Event>, LockFreeQueue<M7Event>, LockFreeQueue<M8Event>> IngestionQueues;
+
+  template<int i>
+  void ingest(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    if (!std::get<i>(*ingestion_queues_).tryPush(evt)) {
+      ingestion_drops_[i].fetch_add(1, std::memory_order_relaxed);
+    }
+    // Make the push visible before checking whether the matcher is waiting. The matcher checks
+    // the queues after announcing that it waits, so either it sees the push or we see it waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (ingestion_waiting_.load()) {
+      // Only held by the matcher while it checks the queues, never while it matches
+      std::lock_guard<std::mutex> lock(ingestion_mutex_);
+      ingestion_cond_.notify_one();
+    }
+  }
+
+  void runIngestion()
+  {
+    std::unique_lock<std::mutex> lock(ingestion_mutex_);
+    while (true) {
+      ingestion_waiting_.store(true);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      ingestion_cond_.wait(lock, [this]() {return ingestion_stopping_ || hasQueuedEvents();});
+      ingestion_waiting_.store(false);
+      if (ingestion_stopping_) {
+        return;
+      }
+      lock.unlock();
+      addQueuedEvents();
+      lock.lock();
+    }
+  }
+
+  void stopIngestion()
+  {
+    if (!ingestion_thread_.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(ingestion_mutex_);
+      ingestion_stopping_ = true;
+    }
+    ingestion_cond_.notify_one();
+    ingestion_thread_.join();
+  }
+
+  // only called by the matcher thread
+  void addQueuedEvents()
+  {
+    while (true) {
+      int64_t oldest_stamp = std::numeric_limits<int64_t>::max();
+      int oldest_index = -1;
+      findOldestQueued<0>(oldest_stamp, oldest_index);
+      findOldestQueued<1>(oldest_stamp, oldest_index);
+      findOldestQueued<2>(oldest_stamp, oldest_index);
+      findOldestQueued<3>(oldest_stamp, oldest_index);
+      findOldestQueued<4>(oldest_stamp, oldest_index);
+      findOldestQueued<5>(oldest_stamp, oldest_index);
+      findOldestQueued<6>(oldest_stamp, oldest_index);
+      findOldestQueued<7>(oldest_stamp, oldest_index);
+      findOldestQueued<8>(oldest_stamp, oldest_index);
+      if (oldest_index < 0) {
+        return;
+      }
+      switch (oldest_index) {
+        case 0:
+          addQueuedFront<0>();
+          break;
+        case 1:
+          addQueuedFront<1>();
+          break;
+        case 2:
+          addQueuedFront<2>();
+          break;
+        case 3:
+          addQueuedFront<3>();
+          break;
+        case 4:
+          addQueuedFront<4>();
+          break;
+        case 5:
+          addQueuedFront<5>();
+          break;
+        case 6:
+          addQueuedFront<6>();
+          break;
+        case 7:
+          addQueuedFront<7>();
+          break;
+        case 8:
+          addQueuedFront<8>();
+          break;
+        default:
+          std::abort();
+      }
+    }
+  }
+
+  // only called by the matcher thread
+  template<int i>
+  void findOldestQueued(int64_t & oldest_stamp, int & oldest_index)
+  {
+    namespace mt = message_filters::message_traits;
+
+    if (i >= RealTypeCount::value) {
+      return;
+    }
+    const typename std::tuple_element<i, Events>::type * evt =
+      std::get<i>(*ingestion_queues_).front();
+    if (!evt) {
+      return;
+    }
+    int64_t stamp = mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(
+      *evt->getMessage()).nanoseconds();
+    if (stamp < oldest_stamp) {
+      oldest_stamp = stamp;
+      oldest_index = i;
+    }
+  }
+
+  // only called by the matcher thread
+  template<int i>
+  void addQueuedFront()
+  {
+    typename std::tuple_element<i, Events>::type evt;
+    if (std::get<i>(*ingestion_queues_).tryPop(evt)) {
+      this->template add<i>(evt);
+    }
+  }
+
+  bool hasQueuedEvents() const
+  {
+    return !std::get<0>(*ingestion_queues_).empty() || !std::get<1>(*ingestion_queues_).empty() ||
+           !std::get<2>(*ingestion_queues_).empty() || !std::get<3>(*ingestion_queues_).empty() ||
+           !std::get<4>(*ingestion_queues_).empty() || !std::get<5>(*ingestion_queues_).empty() ||
+           !std::get<6>(*ingestion_queues_).empty() || !std::get<7>(*ingestion_queues_).empty() ||
+           !std::get<8>(*ingestion_queues_).empty();
   }
 
   uint32_t queue_size_;
@@ -370,6 +987,57 @@ private:
   Connection input_connections_[MAX_MESSAGES];
 
   std::string name_;
+
+  // Tuples matched by the policy and not yet delivered, protected by pending_mutex_
+  std::pmr::unsynchronized_pool_resource pending_pool_;
+  std::pmr::deque<Events> pending_{&pending_pool_};
+  uint64_t queued_count_{0};  // Tuples ever queued, so those that left pending_ are counted too
+  struct PendingDrop
+  {
+    Events events;
+    Signal * signal;
+    uint64_t after;  // The value of queued_count_ when the drop was queued
+  };
+  // Tuples dropped by the policy and not yet reported, protected by pending_mutex_
+  std::pmr::deque<PendingDrop> pending_drops_{&pending_pool_};
+  bool dispatching_{false};
+  std::thread::id dispatcher_;  // The thread delivering tuples, while dispatching_ is set
+  CallbackStats callback_stats_;
+  std::mutex pending_mutex_;
+
+  // Only used once enableOutputLimit() has been called, protected by pending_mutex_
+  size_t output_limit_{0};
+  OutputOverflow output_overflow_{OutputOverflow::DropOldest};
+  uint64_t shed_count_{0};
+  std::condition_variable pending_space_;  // Signaled when a waiting tuple has been taken
+
+  // Only used once enableBatching() has been called, protected by pending_mutex_
+  bool batching_{false};
+  size_t batch_max_size_{0};
+  int64_t batch_window_{std::numeric_limits<int64_t>::max()};
+  int64_t batch_start_{0};  // Stamp of the first message of the oldest tuple in batch_
+  Batch batch_;
+  std::deque<Batch> ready_batches_;  // Complete batches not yet delivered
+
+  std::vector<std::shared_ptr<BatchCallback>> batch_callbacks_;
+  std::mutex batch_callbacks_mutex_;
+
+  // Only used once enableOutputQueue() has been called
+  std::unique_ptr<LockFreeQueue<Events>> output_queue_;
+  std::atomic<uint64_t> output_queue_drops_{0};
+
+  // Only used once enableIngestionQueues() has been called
+  std::unique_ptr<IngestionQueues> ingestion_queues_;
+  std::array<std::atomic<uint64_t>, MAX_MESSAGES> ingestion_drops_{};
+  std::thread ingestion_thread_;  // The matcher, feeding the queues to the policy
+  std::atomic<bool> ingestion_waiting_{false};  // Set while the matcher waits for messages
+  bool ingestion_stopping_{false};  // Protected by ingestion_mutex_
+  std::mutex ingestion_mutex_;
+  std::condition_variable ingestion_cond_;
+
+  // Only used once joinGroup() has been called
+  SyncGroup * group_{nullptr};
+  SyncGroup::MemberId group_member_{0};
 };
 
 template<class ... T>
@@ -0,0 +1,398 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MESSAGE_FILTERS__TIME_MERGER_HPP_
+#define MESSAGE_FILTERS__TIME_MERGER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include "message_filters/connection.hpp"
+#include "message_filters/message_event.hpp"
+#include "message_filters/message_traits.hpp"
+#include "message_filters/null_types.hpp"
+#include "message_filters/ring_buffer.hpp"
+#include "message_filters/signal1.hpp"
+#include "message_filters/synchronizer.hpp"
+
+namespace message_filters
+{
+
+/**
+ * \class TimeMerger
+ *
+ * \brief Merges up to 9 inputs into a single stream ordered by the timestamp of their header.
+ *
+ * \section behavior BEHAVIOR
+ *
+ * Every input is expected to deliver its own messages in nondecreasing timestamp order, as a
+ * single topic usually does. The merger keeps a watermark, the minimum over all inputs of the
+ * latest timestamp received on that input: no input can deliver anything older than the
+ * watermark any more, so every queued message up to the watermark is passed on, in timestamp
+ * order (ties go to the lowest input index). Nothing is passed on until every input has received
+ * a message.
+ *
+ * A message is therefore held only until the slowest input has caught up with it, instead of for
+ * a fixed delay as with the TimeSequencer. An input that falls silent holds back the others; to
+ * bound that, each input queues at most queue_size messages, and when an input overflows, its
+ * oldest message and everything queued before it are passed on without waiting for the
+ * watermark. A message older than one that has already been passed on is thrown away, see
+ * getLateDropCount(). A message that arrives out of order on its own input, but is not older
+ * than that, is queued in its place.
+ *
+ * \section connections CONNECTIONS
+ *
+ * The inputs are connected as with a Synchronizer. Each input has its own output signal with the
+ * signature of an rclcpp subscription callback for that input's message type, registered with
+ * registerCallback<i>(). The callbacks of all the inputs are called one at a time, in the merged
+ * order.
+ */
+template<class M0, class M1, class M2 = NullType, class M3 = NullType, class M4 = NullType,
+  class M5 = NullType, class M6 = NullType, class M7 = NullType, class M8 = NullType>
+class TimeMerger : public noncopyable
+{
+public:
+  typedef PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8> Base;
+  typedef typename Base::Messages Messages;
+  typedef typename Base::Events Events;
+  typedef typename Base::RealTypeCount RealTypeCount;
+
+  static const uint8_t MAX_MESSAGES = 9;
+
+  /**
+   * \brief Constructor
+   *
+   * \param queue_size The maximum number of messages to queue per input, 0 for no limit
+   */
+  explicit TimeMerger(uint32_t queue_size)
+  : queue_size_(queue_size)
+  {
+    latest_stamps_.fill(std::numeric_limits<int64_t>::min());
+  }
+
+  /**
+   * \brief Constructor
+   *
+   * \param queue_size The maximum number of messages to queue per input, 0 for no limit
+   * \param f The filters to connect the inputs to, one per input
+   */
+  template<class ... F>
+  TimeMerger(uint32_t queue_size, F & ... f)
+  : TimeMerger(queue_size)
+  {
+    connectInput(f ...);
+  }
+
+  ~TimeMerger()
+  {
+    disconnectAll();
+  }
+
+  /**
+   * \brief Connect the inputs to the outputs of other filters, one filter per input.
+   */
+  template<class ... F>
+  void connectInput(F & ... f)
+  {
+    static_assert(
+      sizeof...(F) == RealTypeCount::value, "connectInput() needs one filter per input");
+    disconnectAll();
+    connectInputHelper(std::index_sequence_for<F...>(), f ...);
+  }
+
+  /**
+   * \brief Register a callback to be called with the messages of input \p i
+   */
+  template<int i, typename C>
+  Connection registerCallback(const C & callback)
+  {
+    typedef typename std::tuple_element<i, Messages>::type M;
+    return addCallback<i>(std::function<void(const std::shared_ptr<M const> &)>(callback));
+  }
+
+  /**
+   * \brief Register a callback to be called with the messages of input \p i
+   */
+  template<int i, typename P>
+  Connection registerCallback(const std::function<void(P)> & callback)
+  {
+    return addCallback<i>(callback);
+  }
+
+  /**
+   * \brief Register a callback to be called with the messages of input \p i
+   */
+  template<int i, typename T, typename P>
+  Connection registerCallback(void (T::* callback)(P), T * t)
+  {
+    return addCallback<i>(std::function<void(P)>(std::bind(callback, t, std::placeholders::_1)));
+  }
+
+  template<int i>
+  void add(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    namespace mt = message_filters::message_traits;
+    typedef typename std::tuple_element<i, Messages>::type M;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      int64_t stamp = mt::TimeStamp<M>::value(*evt.getMessage()).nanoseconds();
+      if (stamp < released_stamp_) {
+        ++late_drops_;
+        return;
+      }
+
+      auto & queue = std::get<i>(queues_);
+      queue.push_back(evt);
+      // Move it back to its place if it arrived out of order
+      for (size_t n = queue.size() - 1; n > 0 && stamp < stampOf<i>(queue[n - 1]); --n) {
+        std::swap(queue[n], queue[n - 1]);
+      }
+      if (stamp > latest_stamps_[i]) {
+        latest_stamps_[i] = stamp;
+      }
+
+      release(watermark());
+      if (queue_size_ != 0 && queue.size() > queue_size_) {
+        release(stampOf<i>(queue.front()));
+      }
+    }
+    dispatch();
+  }
+
+  template<int i>
+  void add(const std::shared_ptr<typename std::tuple_element<i, Messages>::type const> & msg)
+  {
+    add<i>(typename std::tuple_element<i, Events>::type(msg));
+  }
+
+  /**
+   * \brief Pass on every queued message without waiting for the watermark, e.g. at the end of a
+   * recording.
+   */
+  void flush()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      release(std::numeric_limits<int64_t>::max());
+    }
+    dispatch();
+  }
+
+  /**
+   * \brief The number of messages thrown away because they were older than a message that had
+   * already been passed on.
+   */
+  uint64_t getLateDropCount()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return late_drops_;
+  }
+
+private:
+  typedef std::tuple<RingBuffer<typename Base::M0Event>, RingBuffer<typename Base::M1Event>,
+      RingBuffer<typename Base::M2Event>, RingBuffer<typename Base::M3Event>,
+      RingBuffer<typename Base::M4Event>, RingBuffer<typename Base::M5Event>,
+      RingBuffer<typename Base::M6Event>, RingBuffer<typename Base::M7Event>,
+      RingBuffer<typename Base::M8Event>> Queues;
+  typedef std::tuple<Signal1<M0>, Signal1<M1>, Signal1<M2>, Signal1<M3>, Signal1<M4>,
+      Signal1<M5>, Signal1<M6>, Signal1<M7>, Signal1<M8>> Signals;
+
+  template<class ... F, size_t ... Is>
+  void connectInputHelper(std::index_sequence<Is...> const &, F & ... f)
+  {
+    ((input_connections_[Is] = f.registerCallback(
+      std::function<void(const typename std::tuple_element<Is, Events>::type &)>(
+        std::bind(&TimeMerger::template cb<Is>, this, std::placeholders::_1)))), ...);
+  }
+
+  void disconnectAll()
+  {
+    for (int i = 0; i < MAX_MESSAGES; ++i) {
+      input_connections_[i].disconnect();
+    }
+  }
+
+  template<int i>
+  void cb(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    add<i>(evt);
+  }
+
+  template<int i, typename P>
+  Connection addCallback(const std::function<void(P)> & callback)
+  {
+    auto & signal = std::get<i>(signals_);
+    auto helper = signal.addCallback(callback);
+    return Connection(
+      std::bind(&std::tuple_element<i, Signals>::type::removeCallback, &signal, helper));
+  }
+
+  template<int i>
+  static int64_t stampOf(const typename std::tuple_element<i, Events>::type & evt)
+  {
+    namespace mt = message_filters::message_traits;
+    return mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(
+      *evt.getMessage()).nanoseconds();
+  }
+
+  // assumes mutex_ is already locked
+  int64_t watermark() const
+  {
+    int64_t watermark = std::numeric_limits<int64_t>::max();
+    for (int i = 0; i < RealTypeCount::value; ++i) {
+      watermark = std::min(watermark, latest_stamps_[i]);
+    }
+    return watermark;
+  }
+
+  // Moves the queued messages not newer than <limit> to the pending messages, in timestamp order
+  // assumes mutex_ is already locked
+  void release(int64_t limit)
+  {
+    while (true) {
+      int64_t oldest_stamp = std::numeric_limits<int64_t>::max();
+      int oldest_index = -1;
+      findOldestHelper(oldest_stamp, oldest_index, std::make_index_sequence<MAX_MESSAGES>());
+      if (oldest_index < 0 || oldest_stamp > limit) {
+        return;
+      }
+      releaseFrontHelper(oldest_index, std::make_index_sequence<MAX_MESSAGES>());
+      released_stamp_ = oldest_stamp;
+    }
+  }
+
+  template<size_t ... Is>
+  void findOldestHelper(
+    int64_t & oldest_stamp, int & oldest_index, std::index_sequence<Is...> const &) const
+  {
+    ((findOldest<Is>(oldest_stamp, oldest_index)), ...);
+  }
+
+  // assumes mutex_ is already locked
+  template<int i>
+  void findOldest(int64_t & oldest_stamp, int & oldest_index) const
+  {
+    const auto & queue = std::get<i>(queues_);
+    if (queue.empty()) {
+      return;
+    }
+    int64_t stamp = stampOf<i>(queue.front());
+    if (stamp < oldest_stamp) {
+      oldest_stamp = stamp;
+      oldest_index = i;
+    }
+  }
+
+  template<size_t ... Is>
+  void releaseFrontHelper(int index, std::index_sequence<Is...> const &)
+  {
+    ((index == Is ? releaseFront<Is>() : void()), ...);
+  }
+
+  // assumes mutex_ is already locked
+  template<int i>
+  void releaseFront()
+  {
+    auto & queue = std::get<i>(queues_);
+    std::get<i>(pending_).push_back(queue.front());
+    queue.pop_front();
+    pending_order_.push_back(i);
+  }
+
+  // Delivers the pending messages in the order they were released. If another thread is already
+  // delivering, that thread also delivers the ones released so far, so that the callbacks are
+  // never run concurrently or out of order.
+  void dispatch()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (dispatching_) {
+      return;
+    }
+    dispatching_ = true;
+    while (!pending_order_.empty()) {
+      int index = pending_order_.front();
+      pending_order_.pop_front();
+      try {
+        signalPendingHelper(index, lock, std::make_index_sequence<MAX_MESSAGES>());
+      } catch (...) {
+        lock.lock();
+        dispatching_ = false;
+        throw;
+      }
+    }
+    dispatching_ = false;
+  }
+
+  template<size_t ... Is>
+  void signalPendingHelper(
+    int index, std::unique_lock<std::mutex> & lock, std::index_sequence<Is...> const &)
+  {
+    ((index == Is ? signalPending<Is>(lock) : void()), ...);
+  }
+
+  // Releases <lock> while calling the callbacks, and locks it again afterwards
+  template<int i>
+  void signalPending(std::unique_lock<std::mutex> & lock)
+  {
+    auto & pending = std::get<i>(pending_);
+    typename std::tuple_element<i, Events>::type evt = pending.front();
+    pending.pop_front();
+    lock.unlock();
+    std::get<i>(signals_).call(evt);
+    lock.lock();
+  }
+
+  uint32_t queue_size_;
+
+  Connection input_connections_[MAX_MESSAGES];
+  Signals signals_;
+
+  // Everything below is protected by mutex_
+  std::mutex mutex_;
+  Queues queues_;  // Messages waiting for the watermark, sorted by timestamp
+  std::array<int64_t, MAX_MESSAGES> latest_stamps_;
+  int64_t released_stamp_{std::numeric_limits<int64_t>::min()};
+  uint64_t late_drops_{0};
+
+  // Messages released and not yet delivered. pending_order_ holds their input indices.
+  Queues pending_;
+  RingBuffer<uint8_t> pending_order_;
+  bool dispatching_{false};
+};
+
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__TIME_MERGER_HPP_
@@ -41,6 +41,7 @@
 #include "message_filters/connection.hpp"
 #include "message_filters/message_traits.hpp"
 #include "message_filters/simple_filter.hpp"
+#include "message_filters/sync_group.hpp"
 
 namespace message_filters
 {
@@ -122,6 +123,52 @@ public:
     init();
   }
 
+  /**
+   * \brief Constructor
+   *
+   * This version of the constructor checks for messages which have passed "delay" on a timer of
+   * \p group, and delivers them on one of its workers, instead of creating a timer of its own.
+   *
+   * \param f A filter to connect this sequencer's input to
+   * \param delay The minimum time to hold a message before passing it through.
+   * \param update_rate The rate at which to check for messages which have passed "delay"
+   * \param queue_size The number of messages to store
+   * \param group The group whose timer wheel and workers to use, which must outlive this sequencer
+   */
+  template<class F>
+  TimeSequencer(
+    F & f, rclcpp::Duration delay, rclcpp::Duration update_rate, uint32_t queue_size,
+    SyncGroup & group)
+  : delay_(delay)
+    , update_rate_(update_rate)
+    , queue_size_(queue_size)
+    , group_(&group)
+  {
+    init();
+    connectInput(f);
+  }
+
+  /**
+   * \brief Constructor
+   *
+   * This version of the constructor does not take a filter immediately, and uses the timer wheel
+   * and workers of \p group instead of a timer of its own.
+   *
+   * \param delay The minimum time to hold a message before passing it through.
+   * \param update_rate The rate at which to check for messages which have passed "delay"
+   * \param queue_size The number of messages to store
+   * \param group The group whose timer wheel and workers to use, which must outlive this sequencer
+   */
+  TimeSequencer(
+    rclcpp::Duration delay, rclcpp::Duration update_rate, uint32_t queue_size, SyncGroup & group)
+  : delay_(delay)
+    , update_rate_(update_rate)
+    , queue_size_(queue_size)
+    , group_(&group)
+  {
+    init();
+  }
+
   /**
    * \brief Connect this filter's input to another filter's output.
    */
@@ -139,7 +186,11 @@ public:
 
   ~TimeSequencer()
   {
-    update_timer_->cancel();
+    if (group_) {
+      group_->leave(group_member_);
+    } else {
+      update_timer_->cancel();
+    }
     incoming_connection_.disconnect();
   }
 
@@ -220,6 +271,15 @@ public:
 
   void init()
   {
+    if (group_) {
+      group_member_ = group_->join();
+      group_->addTimer(
+        group_member_, std::chrono::nanoseconds(update_rate_.nanoseconds()), [this]() {
+          dispatch();
+        });
+      return;
+    }
+
     update_timer_ = node_->create_wall_timer(
       std::chrono::nanoseconds(update_rate_.nanoseconds()), [this]() {
         dispatch();
@@ -231,6 +291,8 @@ public:
   uint32_t queue_size_;
   rclcpp::Node::SharedPtr node_;
   rclcpp::TimerBase::SharedPtr update_timer_;
+  SyncGroup * group_{nullptr};  // Replaces node_ and update_timer_ when set
+  SyncGroup::MemberId group_member_{0};
   Connection incoming_connection_;
 
 
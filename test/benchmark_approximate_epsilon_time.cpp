@@ -0,0 +1,121 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Throughput of ApproximateEpsilonTime as a function of its queue size.
+// Not run by default, since it only reports timings.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+
+#include "message_filters/synchronizer.hpp"
+#include "message_filters/sync_policies/approximate_epsilon_time.hpp"
+#include "message_filters/message_traits.hpp"
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+};
+using MsgPtr = std::shared_ptr<Msg>;
+using MsgConstPtr = std::shared_ptr<const Msg>;
+
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg & m)
+  {
+    return m.header.stamp;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
+using Policy = message_filters::sync_policies::ApproximateEpsilonTime<Msg, Msg>;
+using Sync = message_filters::Synchronizer<Policy>;
+
+// Input 0 is kept queue_size messages ahead of input 1, so that every match consumes the oldest
+// of a full queue. Returns the number of matches per second.
+static double matchesPerSecond(uint32_t queue_size)
+{
+  const int64_t period = 1000000;
+  const int matches = 200000;
+  std::vector<MsgPtr> messages(matches + queue_size);
+  for (size_t k = 0; k < messages.size(); ++k) {
+    messages[k] = std::make_shared<Msg>();
+    messages[k]->header.stamp = rclcpp::Time(static_cast<int64_t>(k + 1) * period, RCL_ROS_TIME);
+  }
+
+  Sync sync(Policy(queue_size, rclcpp::Duration(0, 0)));
+  for (uint32_t k = 0; k < queue_size; ++k) {
+    sync.add<0>(messages[k]);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (int k = 0; k < matches; ++k) {
+    sync.add<1>(messages[k]);
+    sync.add<0>(messages[k + queue_size]);
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return matches / elapsed.count();
+}
+
+TEST(ApproxEpsilonTimeBenchmark, throughputIndependentOfQueueSize)
+{
+  double smallest_queue = 0.0;
+  for (uint32_t queue_size : {10u, 100u, 1000u, 10000u}) {
+    double rate = matchesPerSecond(queue_size);
+    std::printf("queue size %5u: %.0f matches/s\n", queue_size, rate);
+    if (smallest_queue == 0.0) {
+      smallest_queue = rate;
+    } else {
+      EXPECT_GT(rate, smallest_queue / 3);
+    }
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}
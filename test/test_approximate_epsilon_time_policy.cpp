@@ -219,6 +219,144 @@ TEST(ApproxTimeSync, ImperfectMatch) {
   sync_test.run();
 }
 
+TEST(ApproxTimeSync, TimeBuckets) {
+  // Buckets of 1s
+  // Input A:  a|..|b.|.c|...
+  // Input B:  A|..|.B|.C|...
+  // Output:   a|..|..|.c|...
+  //           A|..|..|.C|...
+  std::vector<TimeAndTopic> input;
+  std::vector<TimePair> output;
+
+  rclcpp::Time t(0, 0, RCL_ROS_TIME);
+  rclcpp::Duration ms(0, 1000000);
+
+  input.push_back(TimeAndTopic(t + ms * 100, 0));  // a
+  input.push_back(TimeAndTopic(t + ms * 900, 1));  // A
+  input.push_back(TimeAndTopic(t + ms * 2900, 0));  // b
+  input.push_back(TimeAndTopic(t + ms * 3100, 1));  // B, in the next bucket
+  input.push_back(TimeAndTopic(t + ms * 4200, 0));  // c
+  input.push_back(TimeAndTopic(t + ms * 4500, 1));  // C
+  input.push_back(TimeAndTopic(t + ms * 3500, 0));  // Bucket already closed by c
+  input.push_back(TimeAndTopic(t + ms * 3600, 1));  // Bucket already closed by c
+  output.push_back(TimePair(t + ms * 100, t + ms * 900));
+  output.push_back(TimePair(t + ms * 4200, t + ms * 4500));
+
+  ApproximateEpsilonTimeSynchronizerTest sync_test(
+    input, output, 10, rclcpp::Duration::from_seconds(1.0));
+  sync_test.sync_.set_time_buckets(true);
+  sync_test.run();
+}
+
+TEST(ApproxTimeSync, TimeBucketsWindow) {
+  // Two buckets of 1s kept open
+  std::vector<TimeAndTopic> input;
+  std::vector<TimePair> output;
+
+  rclcpp::Time t(0, 0, RCL_ROS_TIME);
+  rclcpp::Duration ms(0, 1000000);
+
+  input.push_back(TimeAndTopic(t + ms * 500, 0));
+  input.push_back(TimeAndTopic(t + ms * 5500, 0));  // Closes the buckets before the 4th
+  input.push_back(TimeAndTopic(t + ms * 600, 1));  // Dropped
+  input.push_back(TimeAndTopic(t + ms * 5200, 1));
+  input.push_back(TimeAndTopic(t + ms * 6100, 0));
+  input.push_back(TimeAndTopic(t + ms * 6300, 0));  // The bucket already has one for this input
+  input.push_back(TimeAndTopic(t + ms * 6500, 1));
+  output.push_back(TimePair(t + ms * 5500, t + ms * 5200));
+  output.push_back(TimePair(t + ms * 6100, t + ms * 6500));
+
+  ApproximateEpsilonTimeSynchronizerTest sync_test(
+    input, output, 2, rclcpp::Duration::from_seconds(1.0));
+  sync_test.sync_.set_time_buckets(true);
+  sync_test.run();
+}
+
+struct PairCollector
+{
+  void callback(const MsgConstPtr & p, const MsgConstPtr & q)
+  {
+    output_.push_back(TimePair(p->header.stamp, q->header.stamp));
+  }
+
+  std::vector<TimePair> output_;
+};
+
+TEST(ApproxTimeSync, AdaptiveQueueSize) {
+  // Input A:  abcdefgh...........z
+  // Input B:  ...ABCDE............Y
+  // B trails A by 300ms, so the queue of A grows to keep 300ms of its messages. Once B falls
+  // silent, its lag decays and the queue of A shrinks back to the few messages it needs, and
+  // Y, 100ms behind z, finds no partner left.
+  typedef message_filters::sync_policies::ApproximateEpsilonTime<Msg, Msg> Policy;
+  rclcpp::Time t(0, 0, RCL_ROS_TIME);
+  rclcpp::Duration ms(0, 1000000);
+
+  message_filters::Synchronizer<Policy> sync(Policy(5, ms));
+  sync.enable_adaptive_queue_size(2, 100);
+  PairCollector collector;
+  sync.registerCallback(&PairCollector::callback, &collector);
+  auto add = [&sync](int i, rclcpp::Time stamp) {
+      MsgPtr m(std::make_shared<Msg>());
+      m->header.stamp = stamp;
+      if (i == 0) {
+        sync.add<0>(m);
+      } else {
+        sync.add<1>(m);
+      }
+    };
+
+  for (int k = 0; k < 300; ++k) {
+    add(0, t + ms * (10 * k));
+    if (k >= 30) {
+      add(1, t + ms * (10 * (k - 30)));
+    }
+  }
+  EXPECT_EQ(sync.get_queue_size(0), 33u);
+  const size_t matched = collector.output_.size();
+  // The first messages of B arrive before the queue of A has grown
+  EXPECT_EQ(matched, 243u);
+
+  for (int k = 300; k < 900; ++k) {
+    add(0, t + ms * (10 * k));
+  }
+  EXPECT_EQ(sync.get_queue_size(0), 3u);
+
+  add(1, t + ms * (10 * 889));
+  EXPECT_EQ(collector.output_.size(), matched);
+}
+
+TEST(ApproxTimeSync, PerInputQueueSize) {
+  // Input A:  abcd..
+  // Input B:  ....AD (A is stamped like a, D like d)
+  // With 2 messages kept for input A, a is gone when A arrives, and only D is matched
+  typedef message_filters::sync_policies::ApproximateEpsilonTime<Msg, Msg> Policy;
+  rclcpp::Time t(0, 0, RCL_ROS_TIME);
+  rclcpp::Duration ms(0, 1000000);
+
+  message_filters::Synchronizer<Policy> sync(Policy(10, ms));
+  sync.set_queue_size(0, 2);
+  EXPECT_EQ(sync.get_queue_size(0), 2u);
+  EXPECT_EQ(sync.get_queue_size(1), 10u);
+  PairCollector collector;
+  sync.registerCallback(&PairCollector::callback, &collector);
+
+  for (int k = 0; k < 4; ++k) {
+    MsgPtr m(std::make_shared<Msg>());
+    m->header.stamp = t + ms * (10 * k);
+    sync.add<0>(m);
+  }
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = t;
+  sync.add<1>(m);
+  EXPECT_TRUE(collector.output_.empty());
+  m = std::make_shared<Msg>();
+  m->header.stamp = t + ms * 30;
+  sync.add<1>(m);
+  ASSERT_EQ(collector.output_.size(), 1u);
+  EXPECT_EQ(collector.output_[0].first, t + ms * 30);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,197 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/synchronizer.hpp"
+#include "message_filters/sync_policies/approximate_time.hpp"
+#include "message_filters/sync_policies/approximate_time_batch.hpp"
+#include "message_filters/message_traits.hpp"
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg & m)
+  {
+    return m.header.stamp;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
+typedef message_filters::sync_policies::ApproximateTime<Msg, Msg, Msg> Policy;
+typedef message_filters::Synchronizer<Policy> Sync3;
+typedef message_filters::sync_policies::ApproximateTimeBatch<3> Batch3;
+
+class StreamingHelper
+{
+public:
+  void cb(const MsgConstPtr & p, const MsgConstPtr & q, const MsgConstPtr & r)
+  {
+    tuples_.push_back(
+      {static_cast<std::size_t>(p->data), static_cast<std::size_t>(q->data),
+        static_cast<std::size_t>(r->data)});
+  }
+
+  std::vector<Batch3::Indices> tuples_;
+};
+
+// Topics at different rates, with jitter and occasional bursts and gaps
+static Batch3::Stamps generate(std::size_t count, unsigned int seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int64_t> jitter(0, 3000000);
+  std::uniform_int_distribution<int> event(0, 99);
+  const std::array<int64_t, 3> periods = {10000000, 33000000, 7000000};
+  Batch3::Stamps stamps;
+  for (std::size_t i = 0; i < 3; ++i) {
+    int64_t t = 1000000000;
+    while (stamps[i].size() < count) {
+      int e = event(gen);
+      if (e < 2) {
+        t += 20 * periods[i];  // Gap
+      }
+      t += (e < 5 ? periods[i] / 10 : periods[i]) + jitter(gen);
+      stamps[i].push_back(t);
+    }
+  }
+  return stamps;
+}
+
+// Reference result: the streaming policy, fed in stamp order
+static std::vector<Batch3::Indices> streaming(
+  const Batch3::Stamps & stamps, uint32_t queue_size, int64_t lower_bound,
+  int64_t max_interval, double age_penalty)
+{
+  Policy policy(queue_size);
+  Sync3 sync(policy);
+  sync.setAgePenalty(age_penalty);
+  sync.setMaxIntervalDuration(rclcpp::Duration::from_nanoseconds(max_interval));
+  for (int i = 0; i < 3; ++i) {
+    sync.setInterMessageLowerBound(i, rclcpp::Duration::from_nanoseconds(lower_bound));
+  }
+  StreamingHelper h;
+  sync.registerCallback(&StreamingHelper::cb, &h);
+
+  std::array<std::size_t, 3> next{};
+  while (true) {
+    int oldest = -1;
+    for (int i = 0; i < 3; ++i) {
+      if (next[i] < stamps[i].size() &&
+        (oldest < 0 || stamps[i][next[i]] < stamps[oldest][next[oldest]]))
+      {
+        oldest = i;
+      }
+    }
+    if (oldest < 0) {
+      break;
+    }
+    MsgPtr m(std::make_shared<Msg>());
+    m->header.stamp = rclcpp::Time(stamps[oldest][next[oldest]], RCL_ROS_TIME);
+    m->data = static_cast<int>(next[oldest]++);
+    switch (oldest) {
+      case 0:
+        sync.add<0>(m);
+        break;
+      case 1:
+        sync.add<1>(m);
+        break;
+      default:
+        sync.add<2>(m);
+        break;
+    }
+  }
+  return h.tuples_;
+}
+
+static std::vector<Batch3::Indices> batch(
+  const Batch3::Stamps & stamps, uint32_t queue_size, int64_t lower_bound,
+  int64_t max_interval, double age_penalty, std::size_t num_threads)
+{
+  Batch3 matcher(queue_size);
+  matcher.setAgePenalty(age_penalty);
+  matcher.setMaxIntervalDuration(rclcpp::Duration::from_nanoseconds(max_interval));
+  for (int i = 0; i < 3; ++i) {
+    matcher.setInterMessageLowerBound(i, rclcpp::Duration::from_nanoseconds(lower_bound));
+  }
+  matcher.setNumThreads(num_threads);
+  return matcher.match(stamps);
+}
+
+TEST(ApproxTimeBatch, MatchesStreaming)
+{
+  const Batch3::Stamps stamps = generate(20000, 1);
+  const int64_t no_limit = rclcpp::Duration::max().nanoseconds();
+
+  // Default parameters, small queues (many drops), rate bounds, limited interval
+  std::vector<Batch3::Indices> expected = streaming(stamps, 10, 0, no_limit, 0.1);
+  ASSERT_GT(expected.size(), 1000u);
+  EXPECT_EQ(batch(stamps, 10, 0, no_limit, 0.1, 1), expected);
+  EXPECT_EQ(batch(stamps, 10, 0, no_limit, 0.1, 8), expected);
+
+  expected = streaming(stamps, 2, 0, no_limit, 0.1);
+  EXPECT_EQ(batch(stamps, 2, 0, no_limit, 0.1, 8), expected);
+
+  expected = streaming(stamps, 10, 500000, no_limit, 0.5);
+  EXPECT_EQ(batch(stamps, 10, 500000, no_limit, 0.5, 8), expected);
+
+  expected = streaming(stamps, 10, 0, 5000000, 0.0);
+  EXPECT_EQ(batch(stamps, 10, 0, 5000000, 0.0, 8), expected);
+}
+
+TEST(ApproxTimeBatch, EmptyTopic)
+{
+  Batch3::Stamps stamps = generate(100, 2);
+  stamps[1].clear();
+  EXPECT_TRUE(batch(stamps, 10, 0, rclcpp::Duration::max().nanoseconds(), 0.1, 4).empty());
+}
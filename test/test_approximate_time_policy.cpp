@@ -28,9 +28,12 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include <rclcpp/rclcpp.hpp>
@@ -532,6 +535,325 @@ TEST(ApproxTimeSync, RateBound) {
   sync_test2.run();
 }
 
+TEST(ApproxTimeSync, Deadline) {
+  // Input A:  a.........
+  // Input B:  ..A..B..C.
+  // Output:   ........a. (deadline 0.5s after A, C forces the publish)
+  //           ........A.
+  std::vector<TimeAndTopic> input;
+  std::vector<TimePair> output;
+
+  rclcpp::Time t(0, 0);
+  rclcpp::Duration s(0, 100000000);
+
+  input.push_back(TimeAndTopic(t, 0));  // a
+  input.push_back(TimeAndTopic(t + s * 2, 1));  // A
+  input.push_back(TimeAndTopic(t + s * 5, 1));  // B
+  input.push_back(TimeAndTopic(t + s * 8, 1));  // C
+
+  // Without a deadline, A is waiting for the next message of input A
+  ApproximateTimeSynchronizerTest sync_test(input, output, 10);
+  sync_test.run();
+
+  output.push_back(TimePair(t, t + s * 2));
+  ApproximateTimeSynchronizerTest sync_test2(input, output, 10);
+  sync_test2.sync_.setDeadline(s * 5);
+  sync_test2.run();
+  EXPECT_EQ(sync_test2.sync_.getDeadlinePublishCount(), 1u);
+
+  // The same, but from a timer, without C
+  input.pop_back();
+  std::vector<TimePair> timer_output;
+  ApproximateTimeSynchronizerTest sync_test3(input, timer_output, 10);
+  sync_test3.sync_.setDeadline(s * 5);
+  sync_test3.run();
+  timer_output.push_back(TimePair(t, t + s * 2));
+  sync_test3.sync_.checkDeadline(t + s * 6);
+  EXPECT_EQ(sync_test3.sync_.getDeadlinePublishCount(), 0u);
+  sync_test3.sync_.checkDeadline(t + s * 7);
+  EXPECT_EQ(sync_test3.sync_.getDeadlinePublishCount(), 1u);
+}
+
+
+typedef message_filters::sync_policies::ApproximateTime<Msg, Msg> ApproxPolicy2;
+typedef message_filters::Synchronizer<ApproxPolicy2> ApproxSync2;
+
+struct BlockingCallbackHelper
+{
+  explicit BlockingCallbackHelper(ApproxSync2 & sync)
+  : sync_(sync)
+  {}
+
+  void callback(const MsgConstPtr &, const MsgConstPtr &)
+  {
+    if (adder_.joinable()) {
+      return;
+    }
+    // Wait, from inside the callback, for another thread to add a message
+    std::future<void> added = added_.get_future();
+    adder_ = std::thread(
+      [this]() {
+        MsgPtr m(std::make_shared<Msg>());
+        m->header.stamp = rclcpp::Time(10, 0);
+        sync_.add<0>(m);
+        added_.set_value();
+      });
+    added_while_in_callback_ =
+      added.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+  }
+
+  ApproxSync2 & sync_;
+  std::promise<void> added_;
+  std::thread adder_;
+  bool added_while_in_callback_{false};
+};
+
+TEST(ApproxTimeSync, CallbackDoesNotBlockInputs) {
+  ApproxSync2 sync(10);
+  BlockingCallbackHelper h(sync);
+  sync.registerCallback(&BlockingCallbackHelper::callback, &h);
+
+  rclcpp::Time t(0, 0);
+  rclcpp::Duration s(1, 0);
+  MsgPtr p(std::make_shared<Msg>());
+  p->header.stamp = t;
+  sync.add<0>(p);
+  MsgPtr q(std::make_shared<Msg>());
+  q->header.stamp = t;
+  sync.add<1>(q);
+  MsgPtr r(std::make_shared<Msg>());
+  r->header.stamp = t + s;
+  sync.add<1>(r);
+
+  ASSERT_TRUE(h.adder_.joinable());
+  h.adder_.join();
+  EXPECT_TRUE(h.added_while_in_callback_);
+}
+
+
+struct PairCollector
+{
+  void callback(const MsgConstPtr & p, const MsgConstPtr & q)
+  {
+    output_.push_back(TimePair(p->header.stamp, q->header.stamp));
+  }
+
+  std::vector<TimePair> output_;
+};
+
+TEST(ApproxTimeSync, PerInputQueueLimits) {
+  // Input A:  abcdefghij..kl
+  // Input B:  ..........AB.. (A is stamped 2, B is stamped 10)
+  // A fast input with a lagging slow one: how far back input A reaches when A arrives decides
+  // whether A can be matched with c.
+  rclcpp::Time t(0, 0);
+  rclcpp::Duration s(1, 0);
+
+  auto run = [&](ApproxSync2 & sync) {
+      PairCollector collector;
+      sync.registerCallback(&PairCollector::callback, &collector);
+      for (int i = 0; i < 10; ++i) {
+        MsgPtr p(std::make_shared<Msg>());
+        p->header.stamp = t + s * i;
+        sync.add<0>(p);
+      }
+      for (int i : {2, 10}) {
+        MsgPtr q(std::make_shared<Msg>());
+        q->header.stamp = t + s * i;
+        sync.add<1>(q);
+      }
+      for (int i : {10, 11}) {
+        MsgPtr p(std::make_shared<Msg>());
+        p->header.stamp = t + s * i;
+        sync.add<0>(p);
+      }
+      return collector.output_;
+    };
+
+  // A has dropped a to g when A arrives, so A is never matched
+  ApproxSync2 sync(3);
+  std::vector<TimePair> output = run(sync);
+  ASSERT_EQ(output.size(), 1u);
+  EXPECT_EQ(output[0], TimePair(t + s * 10, t + s * 10));
+
+  // A larger queue for input A only
+  ApproxSync2 sync_sizes(ApproxPolicy2(std::vector<uint32_t>{10, 3}));
+  output = run(sync_sizes);
+  ASSERT_EQ(output.size(), 2u);
+  EXPECT_EQ(output[0], TimePair(t + s * 2, t + s * 2));
+  EXPECT_EQ(output[1], TimePair(t + s * 10, t + s * 10));
+
+  // A span too short to reach back to c, whatever the queue size
+  ApproxSync2 sync_short_span(100);
+  sync_short_span.setQueueSpan(0, s * 5);
+  output = run(sync_short_span);
+  ASSERT_EQ(output.size(), 1u);
+
+  ApproxSync2 sync_span(100);
+  sync_span.setQueueSpan(0, s * 8);
+  output = run(sync_span);
+  ASSERT_EQ(output.size(), 2u);
+  EXPECT_EQ(output[0], TimePair(t + s * 2, t + s * 2));
+
+  // With both limits, whichever is reached first applies
+  ApproxSync2 sync_both(ApproxPolicy2(std::vector<uint32_t>{3, 3}));
+  sync_both.setQueueSpan(0, s * 8);
+  output = run(sync_both);
+  ASSERT_EQ(output.size(), 1u);
+}
+
+
+TEST(ApproxTimeSync, LearnedRateBound) {
+  // Input A:  a..b..c..d..
+  // Input B:  .A..B..C..D.
+  // Without a bound, the pair of A is only published when b arrives. Once the gaps of input A
+  // are learned, a gap of at least 2.4s is assumed after a, and it is published when A arrives.
+  rclcpp::Time t(0, 0);
+  rclcpp::Duration s(1, 0);
+
+  ApproxSync2 sync(10);
+  PairCollector collector;
+  sync.registerCallback(&PairCollector::callback, &collector);
+  sync.enableInterMessageLowerBoundEstimation();
+
+  size_t published_on_arrival = 0;
+  int64_t k = 0;
+  auto step = [&](rclcpp::Duration gap) {
+      MsgPtr p(std::make_shared<Msg>());
+      p->header.stamp = t;
+      sync.add<0>(p);
+      MsgPtr q(std::make_shared<Msg>());
+      q->header.stamp = t + s;
+      const size_t before = collector.output_.size();
+      sync.add<1>(q);
+      if (collector.output_.size() > before) {
+        ++published_on_arrival;
+      }
+      t = t + gap;
+      ++k;
+    };
+
+  for (int n = 0; n < 32; ++n) {
+    step(s * 3);
+  }
+  EXPECT_EQ(published_on_arrival, 0u);
+  EXPECT_EQ(sync.getInterMessageLowerBound(0), rclcpp::Duration(0, 0));
+  for (int n = 0; n < 10; ++n) {
+    step(s * 3);
+  }
+  EXPECT_EQ(sync.getInterMessageLowerBound(0), s * 2.4);
+  EXPECT_EQ(sync.getInterMessageLowerBound(1), s * 2.4);
+  EXPECT_EQ(published_on_arrival, 10u);
+  EXPECT_EQ(collector.output_.size(), static_cast<size_t>(k));
+
+  // A gap of 1.5s on both inputs breaks both bounds, which fall back to 0 before the messages
+  // are processed
+  step(s * 1.5);
+  step(s * 3);
+  EXPECT_EQ(sync.getInterMessageBoundViolationCount(), 2u);
+  EXPECT_EQ(sync.getInterMessageLowerBound(0), rclcpp::Duration(0, 0));
+  EXPECT_EQ(sync.getInterMessageLowerBound(1), rclcpp::Duration(0, 0));
+  EXPECT_EQ(published_on_arrival, 11u);
+  EXPECT_EQ(collector.output_.size(), static_cast<size_t>(k - 1));
+  for (size_t n = 0; n < collector.output_.size(); ++n) {
+    EXPECT_EQ(collector.output_[n].second - collector.output_[n].first, s);
+  }
+}
+
+TEST(ApproxTimeSync, LearnedRateBoundOutOfOrder) {
+  // Input A:  a..b..c..d..  then  x(w)..
+  // Input B:  .A..B..C..D.        ...X
+  // Once the bounds are learned, a pair is published as soon as its message of B arrives. The
+  // message w of input A is older than x: the bound of A no longer holds, so the pair of X must
+  // wait for the next message of A instead of assuming that none can arrive before x + 2.4s.
+  rclcpp::Time t(0, 0);
+  rclcpp::Duration s(1, 0);
+
+  ApproxSync2 sync(10);
+  PairCollector collector;
+  sync.registerCallback(&PairCollector::callback, &collector);
+  sync.enableInterMessageLowerBoundEstimation();
+
+  auto add = [&sync](int i, rclcpp::Time stamp) {
+      MsgPtr p(std::make_shared<Msg>());
+      p->header.stamp = stamp;
+      if (i == 0) {
+        sync.add<0>(p);
+      } else {
+        sync.add<1>(p);
+      }
+    };
+
+  for (int n = 0; n < 42; ++n) {
+    add(0, t);
+    add(1, t + s);
+    t = t + s * 3;
+  }
+  ASSERT_EQ(sync.getInterMessageLowerBound(0), s * 2.4);
+  const size_t published = collector.output_.size();
+  ASSERT_EQ(published, 42u);
+
+  add(0, t);
+  add(0, t - s * 0.5);
+  EXPECT_EQ(sync.getInterMessageBoundViolationCount(), 1u);
+  EXPECT_EQ(sync.getInterMessageLowerBound(0), rclcpp::Duration(0, 0));
+  add(1, t + s * 0.5);
+  EXPECT_EQ(collector.output_.size(), published);
+
+  add(0, t + s * 3);
+  ASSERT_EQ(collector.output_.size(), published + 1);
+  EXPECT_EQ(collector.output_.back().first, t);
+  EXPECT_EQ(collector.output_.back().second, t + s * 0.5);
+}
+
+TEST(ApproxTimeSync, AdaptiveQueueSize) {
+  // Input A:  abcdefgh...........z...
+  // Input B:  ...ABCDE............Y..
+  // B trails A by 300ms, so the queue of A grows to keep 300ms of its messages. Once B falls
+  // silent, its lag decays and the queue of A shrinks back to the few messages it needs: the
+  // message of A stamped like Y, 100ms behind z, is gone, and Y is dropped.
+  rclcpp::Time t(0, 0);
+  rclcpp::Duration ms(0, 1000000);
+
+  ApproxSync2 sync(5);
+  sync.enableAdaptiveQueueSize(2, 100);
+  PairCollector collector;
+  sync.registerCallback(&PairCollector::callback, &collector);
+  auto add = [&sync](int i, rclcpp::Time stamp) {
+      MsgPtr m(std::make_shared<Msg>());
+      m->header.stamp = stamp;
+      if (i == 0) {
+        sync.add<0>(m);
+      } else {
+        sync.add<1>(m);
+      }
+    };
+
+  for (int k = 0; k < 300; ++k) {
+    add(0, t + ms * (10 * k));
+    if (k >= 30) {
+      add(1, t + ms * (10 * (k - 30)));
+    }
+  }
+  EXPECT_EQ(sync.getQueueSize(0), 33u);
+  const size_t matched = collector.output_.size();
+  for (size_t n = 4; n < matched; ++n) {
+    EXPECT_EQ(collector.output_[n].first, collector.output_[n].second);
+  }
+
+  for (int k = 300; k < 900; ++k) {
+    add(0, t + ms * (10 * k));
+  }
+  EXPECT_EQ(sync.getQueueSize(0), 3u);
+
+  add(1, t + ms * (10 * 889));
+  add(1, t + ms * (10 * 900));
+  add(0, t + ms * (10 * 900));
+  ASSERT_EQ(collector.output_.size(), matched + 1);
+  EXPECT_EQ(collector.output_[matched].first, t + ms * (10 * 900));
+  EXPECT_EQ(collector.output_[matched].second, t + ms * (10 * 900));
+}
+
 
 int main(int argc, char ** argv)
 {
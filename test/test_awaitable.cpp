@@ -0,0 +1,201 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/awaitable.hpp"
+#include "message_filters/pass_through.hpp"
+#include "message_filters/synchronizer.hpp"
+#include "message_filters/sync_policies/exact_time.hpp"
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg & m)
+  {
+    return m.header.stamp;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
+MsgPtr makeMsg(int64_t stamp)
+{
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = rclcpp::Time(stamp);
+  return m;
+}
+
+#ifdef MESSAGE_FILTERS_HAS_COROUTINES
+
+typedef message_filters::sync_policies::ExactTime<Msg, Msg> Policy2;
+typedef message_filters::Synchronizer<Policy2> Sync2;
+
+// Coroutine that starts right away and is never waited on
+struct Task
+{
+  struct promise_type
+  {
+    Task get_return_object() {return Task();}
+    std::suspend_never initial_suspend() {return {};}
+    std::suspend_never final_suspend() noexcept {return {};}
+    void return_void() {}
+    void unhandled_exception() {std::terminate();}
+  };
+};
+
+Task readStamps(
+  message_filters::AwaitableFilter<Msg> & events, int count, std::vector<int64_t> & stamps,
+  message_filters::AwaitExecutor executor = message_filters::AwaitExecutor())
+{
+  for (int i = 0; i < count; ++i) {
+    message_filters::MessageEvent<Msg const> event = co_await events.next(executor);
+    stamps.push_back(event.getMessage()->header.stamp.nanoseconds());
+  }
+}
+
+TEST(Awaitable, filter)
+{
+  message_filters::PassThrough<Msg> f;
+  message_filters::AwaitableFilter<Msg> events(f);
+
+  // Events that arrive before anybody waits are queued
+  f.add(makeMsg(1));
+  f.add(makeMsg(2));
+
+  std::vector<int64_t> stamps;
+  readStamps(events, 4, stamps);
+  EXPECT_EQ(stamps, (std::vector<int64_t>{1, 2}));
+
+  // The coroutine is now waiting, and is resumed by each new event
+  f.add(makeMsg(3));
+  EXPECT_EQ(stamps, (std::vector<int64_t>{1, 2, 3}));
+  f.add(makeMsg(4));
+  EXPECT_EQ(stamps, (std::vector<int64_t>{1, 2, 3, 4}));
+
+  // Done waiting
+  f.add(makeMsg(5));
+  EXPECT_EQ(events.size(), 1u);
+}
+
+TEST(Awaitable, executor)
+{
+  message_filters::PassThrough<Msg> f;
+  message_filters::AwaitableFilter<Msg> events(f);
+  std::vector<std::function<void()>> posted;
+  message_filters::AwaitExecutor executor = [&posted](std::function<void()> work) {
+      posted.push_back(std::move(work));
+    };
+
+  std::vector<int64_t> stamps;
+  readStamps(events, 1, stamps, executor);
+  f.add(makeMsg(7));
+  // Resumed only when the executor runs it
+  EXPECT_TRUE(stamps.empty());
+  ASSERT_EQ(posted.size(), 1u);
+  posted[0]();
+  EXPECT_EQ(stamps, (std::vector<int64_t>{7}));
+}
+
+TEST(Awaitable, queueSize)
+{
+  message_filters::PassThrough<Msg> f;
+  message_filters::AwaitableFilter<Msg> events(f, 2);
+  for (int64_t stamp = 1; stamp <= 5; ++stamp) {
+    f.add(makeMsg(stamp));
+  }
+  EXPECT_EQ(events.getDropCount(), 3u);
+
+  std::vector<int64_t> stamps;
+  readStamps(events, 2, stamps);
+  EXPECT_EQ(stamps, (std::vector<int64_t>{4, 5}));
+}
+
+Task readTuples(
+  message_filters::AwaitableSynchronizer<Sync2> & tuples, int count, std::vector<int64_t> & out)
+{
+  for (int i = 0; i < count; ++i) {
+    Sync2::Events events = co_await tuples.next();
+    out.push_back(std::get<0>(events).getMessage()->header.stamp.nanoseconds());
+    out.push_back(std::get<1>(events).getMessage()->header.stamp.nanoseconds());
+  }
+}
+
+TEST(Awaitable, synchronizer)
+{
+  Sync2 sync(10);
+  message_filters::AwaitableSynchronizer<Sync2> tuples(sync);
+  std::vector<int64_t> out;
+  readTuples(tuples, 2, out);
+
+  sync.add<0>(makeMsg(1));
+  sync.add<0>(makeMsg(2));
+  sync.add<1>(makeMsg(2));
+  EXPECT_EQ(out, (std::vector<int64_t>{2, 2}));
+  sync.add<1>(makeMsg(3));
+  sync.add<0>(makeMsg(3));
+  EXPECT_EQ(out, (std::vector<int64_t>{2, 2, 3, 3}));
+}
+
+#else
+
+TEST(Awaitable, unavailable)
+{
+  GTEST_SKIP() << "C++20 coroutines are not enabled";
+}
+
+#endif  // MESSAGE_FILTERS_HAS_COROUTINES
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,203 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/synchronizer.hpp"
+#include "message_filters/sync_policies/exact_key.hpp"
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+  uint64_t frame;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct MatchKey<Msg>
+{
+  static uint64_t value(const Msg & m)
+  {
+    return m.frame;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
+typedef message_filters::sync_policies::ExactKey<Msg, Msg> Policy2;
+typedef message_filters::sync_policies::ExactKey<Msg, Msg, Msg> Policy3;
+typedef message_filters::Synchronizer<Policy2> Sync2;
+typedef message_filters::Synchronizer<Policy3> Sync3;
+
+// Records the keys of the signaled and of the dropped tuples
+class Helper
+{
+public:
+  void cb2(const MsgConstPtr & a, const MsgConstPtr & b)
+  {
+    EXPECT_EQ(a->frame, b->frame);
+    out_.push_back(a->frame);
+  }
+
+  void cb3(const MsgConstPtr & a, const MsgConstPtr & b, const MsgConstPtr & c)
+  {
+    EXPECT_EQ(a->frame, b->frame);
+    EXPECT_EQ(a->frame, c->frame);
+    out_.push_back(a->frame);
+  }
+
+  void dropcb3(const MsgConstPtr & a, const MsgConstPtr & b, const MsgConstPtr & c)
+  {
+    const MsgConstPtr & m = a ? a : (b ? b : c);
+    drops_.push_back(m->frame);
+  }
+
+  std::vector<uint64_t> out_;
+  std::vector<uint64_t> drops_;
+};
+
+MsgPtr makeMsg(uint64_t frame, int64_t stamp = 0)
+{
+  MsgPtr m(std::make_shared<Msg>());
+  m->frame = frame;
+  m->header.stamp = rclcpp::Time(stamp);
+  return m;
+}
+
+TEST(ExactKey, matchesOnKey)
+{
+  Sync3 sync(10);
+  Helper h;
+  sync.registerCallback(
+    std::bind(
+      &Helper::cb3, &h, std::placeholders::_1, std::placeholders::_2,
+      std::placeholders::_3));
+
+  // The stamps disagree, the frame counters do not
+  sync.add<0>(makeMsg(7, 100));
+  sync.add<1>(makeMsg(7, 250));
+  sync.add<0>(makeMsg(8, 200));
+  EXPECT_TRUE(h.out_.empty());
+  sync.add<2>(makeMsg(7, 90));
+  EXPECT_EQ(h.out_, (std::vector<uint64_t>{7}));
+
+  // Completing 9 does not drop 8, keys need not be ordered
+  sync.add<0>(makeMsg(9));
+  sync.add<1>(makeMsg(9));
+  sync.add<2>(makeMsg(9));
+  sync.add<1>(makeMsg(8));
+  sync.add<2>(makeMsg(8));
+  EXPECT_EQ(h.out_, (std::vector<uint64_t>{7, 9, 8}));
+}
+
+TEST(ExactKey, queueSize)
+{
+  Sync3 sync(2);
+  Helper h;
+  sync.registerCallback(
+    std::bind(
+      &Helper::cb3, &h, std::placeholders::_1, std::placeholders::_2,
+      std::placeholders::_3));
+  sync.getPolicy()->registerDropCallback(
+    std::bind(
+      &Helper::dropcb3, &h, std::placeholders::_1, std::placeholders::_2,
+      std::placeholders::_3));
+
+  sync.add<0>(makeMsg(1));
+  sync.add<0>(makeMsg(2));
+  EXPECT_TRUE(h.drops_.empty());
+  sync.add<1>(makeMsg(3));
+  // The oldest incomplete tuple is dropped
+  EXPECT_EQ(h.drops_, (std::vector<uint64_t>{1}));
+  sync.add<1>(makeMsg(2));
+  sync.add<2>(makeMsg(2));
+  EXPECT_EQ(h.out_, (std::vector<uint64_t>{2}));
+}
+
+TEST(ExactKey, maxAge)
+{
+  Sync3 sync(0);
+  sync.setMaxAge(3);
+  Helper h;
+  sync.getPolicy()->registerDropCallback(
+    std::bind(
+      &Helper::dropcb3, &h, std::placeholders::_1, std::placeholders::_2,
+      std::placeholders::_3));
+
+  for (uint64_t frame = 0; frame < 4; ++frame) {
+    sync.add<0>(makeMsg(frame));
+  }
+  EXPECT_TRUE(h.drops_.empty());
+  sync.add<0>(makeMsg(4));
+  EXPECT_EQ(h.drops_, (std::vector<uint64_t>{0}));
+}
+
+TEST(ExactKey, manyPendingTuples)
+{
+  // Unbounded, with tens of thousands of incomplete tuples at once, completed in random order
+  const uint64_t count = 20000;
+  Sync2 sync(0);
+  Helper h;
+  sync.registerCallback(
+    std::bind(&Helper::cb2, &h, std::placeholders::_1, std::placeholders::_2));
+
+  std::vector<uint64_t> frames(count);
+  for (uint64_t k = 0; k < count; ++k) {
+    frames[k] = k * 0x10000;  // Keys sharing their low bits
+    sync.add<0>(makeMsg(frames[k]));
+  }
+  std::shuffle(frames.begin(), frames.end(), std::mt19937(42));
+  for (uint64_t frame : frames) {
+    sync.add<1>(makeMsg(frame));
+  }
+  EXPECT_EQ(h.out_, frames);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}
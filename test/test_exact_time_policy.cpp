@@ -30,6 +30,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include <rclcpp/rclcpp.hpp>
 #include "message_filters/synchronizer.hpp"
@@ -158,6 +159,40 @@ TEST(ExactTime, dropCallback)
   ASSERT_EQ(h.drop_count_, 1);
 }
 
+TEST(ExactTime, outOfOrderStamps)
+{
+  Sync3 sync(0);
+  Helper h;
+  sync.registerCallback(std::bind(&Helper::cb, &h));
+  sync.getPolicy()->registerDropCallback(std::bind(&Helper::dropcb, &h));
+
+  // Enough pending stamps, in no particular order, to need room beyond the initial storage
+  const int stamps[] = {30, 10, 20, 50, 40, 70, 60, 90, 80, 100, 15, 25};
+  for (int stamp : stamps) {
+    MsgPtr m(std::make_shared<Msg>());
+    m->header.stamp = rclcpp::Time(stamp * 1000000LL);
+    sync.add<0>(m);
+  }
+  ASSERT_EQ(h.count_, 0);
+  ASSERT_EQ(h.drop_count_, 0);
+
+  // Completing 25 drops the tuples for 10, 15 and 20, which are older
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = rclcpp::Time(25000000LL);
+  sync.add<1>(m);
+  sync.add<2>(m);
+  ASSERT_EQ(h.count_, 1);
+  ASSERT_EQ(h.drop_count_, 3);
+  ASSERT_EQ(sync.getPolicy()->getLastSignalTime(), m->header.stamp);
+
+  m = std::make_shared<Msg>();
+  m->header.stamp = rclcpp::Time(100000000LL);
+  sync.add<2>(m);
+  sync.add<1>(m);
+  ASSERT_EQ(h.count_, 2);
+  ASSERT_EQ(h.drop_count_, 10);
+}
+
 struct EventHelper
 {
   void callback(
@@ -188,6 +223,84 @@ TEST(ExactTime, eventInEventOut)
   ASSERT_EQ(h.e2_.getReceiptTime(), evt.getReceiptTime());
 }
 
+TEST(ExactTime, adaptiveQueueSize)
+{
+  // Input 0 at 100 Hz, input 1 at 10 Hz and 300 ms late: 2 tuples are far too few to wait for it
+  const int64_t ms = 1000000;
+  auto run = [ms](Sync2 & sync, Helper & h) {
+      sync.registerCallback(std::bind(&Helper::cb, &h));
+      for (int64_t t = 0; t < 3000 * ms; t += 10 * ms) {
+        MsgPtr m(std::make_shared<Msg>());
+        m->header.stamp = rclcpp::Time(t);
+        sync.add<0>(m);
+        if (t % (100 * ms) == 0 && t >= 300 * ms) {
+          MsgPtr n(std::make_shared<Msg>());
+          n->header.stamp = rclcpp::Time(t - 300 * ms);
+          sync.add<1>(n);
+        }
+      }
+    };
+
+  Sync2 fixed(2);
+  Helper h_fixed;
+  run(fixed, h_fixed);
+  EXPECT_EQ(h_fixed.count_, 0);
+
+  Sync2 adaptive(2);
+  adaptive.enableAdaptiveQueueSize(2, 100);
+  Helper h_adaptive;
+  run(adaptive, h_adaptive);
+  // Of the 27 messages of input 1, only those whose tuple was dropped before the queue grew,
+  // in the first 400 ms, are not matched
+  EXPECT_EQ(h_adaptive.count_, 27 - 4);
+  EXPECT_GE(adaptive.getQueueSize(), 40u);
+  EXPECT_LE(adaptive.getQueueSize(), 100u);
+  EXPECT_EQ(adaptive.getQueueSizeTuner().period(1), 100 * ms);
+}
+
+TEST(ExactTime, maxTupleAge)
+{
+  const int64_t ms = 1000000;
+  Sync3 sync(100);
+  sync.getPolicy()->setMaxTupleAge(rclcpp::Duration::from_nanoseconds(50 * ms));
+  Helper h;
+  sync.registerCallback(std::bind(&Helper::cb, &h));
+  sync.getPolicy()->registerDropCallback(std::bind(&Helper::dropcb, &h));
+  auto add = [&sync](int i, int64_t t) {
+      MsgPtr m(std::make_shared<Msg>());
+      m->header.stamp = rclcpp::Time(t);
+      if (i == 0) {
+        sync.add<0>(m);
+      } else if (i == 1) {
+        sync.add<1>(m);
+      } else {
+        sync.add<2>(m);
+      }
+    };
+
+  // Input 2 is silent, the partial tuples go once the other inputs are 50 ms ahead of them
+  for (int64_t t = 0; t <= 20 * ms; t += 10 * ms) {
+    add(0, t);
+    add(1, t);
+  }
+  ASSERT_EQ(h.drop_count_, 0);
+  add(0, 60 * ms);
+  ASSERT_EQ(h.drop_count_, 1);
+  add(0, 100 * ms);
+  ASSERT_EQ(h.drop_count_, 3);
+
+  // Input 2 is back, its first tuple completes and drops the older one at 60 ms
+  add(1, 100 * ms);
+  add(2, 100 * ms);
+  ASSERT_EQ(h.count_, 1);
+  ASSERT_EQ(h.drop_count_, 4);
+
+  // A message already too old when it arrives is dropped right away
+  add(2, 10 * ms);
+  ASSERT_EQ(h.drop_count_, 5);
+  ASSERT_EQ(h.count_, 1);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
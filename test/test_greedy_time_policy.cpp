@@ -0,0 +1,298 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/synchronizer.hpp"
+#include "message_filters/sync_policies/approximate_time_batch.hpp"
+#include "message_filters/sync_policies/greedy_time.hpp"
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg & m)
+  {
+    return m.header.stamp;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
+typedef message_filters::sync_policies::GreedyTime<Msg, Msg> Policy2;
+typedef message_filters::sync_policies::GreedyTime<Msg, Msg, Msg> Policy3;
+typedef message_filters::Synchronizer<Policy2> Sync2;
+typedef message_filters::Synchronizer<Policy3> Sync3;
+typedef message_filters::sync_policies::ApproximateTimeBatch<3> Batch3;
+
+typedef std::vector<std::vector<int64_t>> Tuples;
+
+// Records the stamps, or with indices_ set the data fields, of the signaled tuples
+class Helper
+{
+public:
+  void cb2(const MsgConstPtr & p, const MsgConstPtr & q)
+  {
+    out_.push_back({value(p), value(q)});
+  }
+
+  void cb3(const MsgConstPtr & p, const MsgConstPtr & q, const MsgConstPtr & r)
+  {
+    out_.push_back({value(p), value(q), value(r)});
+  }
+
+  int64_t value(const MsgConstPtr & m) const
+  {
+    return indices_ ? m->data : m->header.stamp.nanoseconds();
+  }
+
+  bool indices_ = false;
+  Tuples out_;
+};
+
+MsgPtr makeMsg(int64_t stamp, int data = 0)
+{
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = rclcpp::Time(stamp);
+  m->data = data;
+  return m;
+}
+
+TEST(GreedyTime, window)
+{
+  Sync2 sync(Policy2(10, rclcpp::Duration(0, 5)));
+  Helper h;
+  sync.registerCallback(
+    std::bind(&Helper::cb2, &h, std::placeholders::_1, std::placeholders::_2));
+
+  sync.add<0>(makeMsg(10));
+  EXPECT_TRUE(h.out_.empty());
+  sync.add<1>(makeMsg(13));
+  EXPECT_EQ(h.out_, (Tuples{{10, 13}}));
+
+  sync.add<1>(makeMsg(30));
+  sync.add<0>(makeMsg(40));
+  EXPECT_EQ(h.out_.size(), 1u);
+  sync.add<1>(makeMsg(42));
+  EXPECT_EQ(h.out_, (Tuples{{10, 13}, {40, 42}}));
+
+  // Matched messages are not reused
+  sync.add<0>(makeMsg(43));
+  EXPECT_EQ(h.out_.size(), 2u);
+}
+
+TEST(GreedyTime, nearest)
+{
+  Sync2 sync(Policy2(10, rclcpp::Duration(0, 5)));
+  Helper h;
+  sync.registerCallback(
+    std::bind(&Helper::cb2, &h, std::placeholders::_1, std::placeholders::_2));
+
+  sync.add<1>(makeMsg(8));
+  sync.add<1>(makeMsg(11));
+  sync.add<1>(makeMsg(14));
+  sync.add<0>(makeMsg(12));
+  EXPECT_EQ(h.out_, (Tuples{{12, 11}}));
+
+  // 14 is still available
+  sync.add<0>(makeMsg(15));
+  EXPECT_EQ(h.out_, (Tuples{{12, 11}, {15, 14}}));
+}
+
+TEST(GreedyTime, searchDepth)
+{
+  for (uint32_t depth : {2, 5}) {
+    Sync2 sync(Policy2(10, rclcpp::Duration(0, 5)));
+    sync.setSearchDepth(depth);
+    Helper h;
+    sync.registerCallback(
+      std::bind(&Helper::cb2, &h, std::placeholders::_1, std::placeholders::_2));
+
+    for (int64_t stamp : {10, 20, 21, 22, 23}) {
+      sync.add<1>(makeMsg(stamp));
+    }
+    sync.add<0>(makeMsg(10));
+    EXPECT_EQ(h.out_, depth == 2 ? Tuples{} : (Tuples{{10, 10}}));
+  }
+}
+
+TEST(GreedyTime, allInputs)
+{
+  Sync3 sync(Policy3(10, rclcpp::Duration(0, 5)));
+  Helper h;
+  sync.registerCallback(
+    std::bind(
+      &Helper::cb3, &h, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+
+  sync.add<0>(makeMsg(100));
+  sync.add<1>(makeMsg(102));
+  EXPECT_TRUE(h.out_.empty());
+  sync.add<2>(makeMsg(97));
+  EXPECT_EQ(h.out_, (Tuples{{100, 102, 97}}));
+}
+
+// Topics at different rates, with jitter and occasional bursts and gaps
+static Batch3::Stamps generate(std::size_t count, unsigned int seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int64_t> jitter(0, 3000000);
+  std::uniform_int_distribution<int> event(0, 99);
+  const std::array<int64_t, 3> periods = {10000000, 33000000, 7000000};
+  Batch3::Stamps stamps;
+  for (std::size_t i = 0; i < 3; ++i) {
+    int64_t t = 1000000000;
+    while (stamps[i].size() < count) {
+      int e = event(gen);
+      if (e < 2) {
+        t += 20 * periods[i];  // Gap
+      }
+      t += (e < 5 ? periods[i] / 10 : periods[i]) + jitter(gen);
+      stamps[i].push_back(t);
+    }
+  }
+  return stamps;
+}
+
+static double meanSpread(const Batch3::Stamps & stamps, const Tuples & tuples)
+{
+  double total = 0;
+  for (const auto & t : tuples) {
+    std::array<int64_t, 3> s = {stamps[0][t[0]], stamps[1][t[1]], stamps[2][t[2]]};
+    total += *std::max_element(s.begin(), s.end()) - *std::min_element(s.begin(), s.end());
+  }
+  return tuples.empty() ? 0 : total / tuples.size();
+}
+
+// Reports how the greedy tuples compare with those ApproximateTime finds on the same streams
+TEST(GreedyTime, qualityVersusApproximateTime)
+{
+  const int64_t window = 10000000;
+  const Batch3::Stamps stamps = generate(3000, 7);
+
+  Sync3 sync(Policy3(100, rclcpp::Duration::from_nanoseconds(window)));
+  Helper h;
+  h.indices_ = true;
+  sync.registerCallback(
+    std::bind(
+      &Helper::cb3, &h, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+  // Feed the streams in stamp order, as they would have been received
+  std::array<std::size_t, 3> next = {0, 0, 0};
+  while (true) {
+    int oldest = -1;
+    for (int i = 0; i < 3; ++i) {
+      if (next[i] < stamps[i].size() &&
+        (oldest < 0 || stamps[i][next[i]] < stamps[oldest][next[oldest]]))
+      {
+        oldest = i;
+      }
+    }
+    if (oldest < 0) {
+      break;
+    }
+    MsgPtr m = makeMsg(stamps[oldest][next[oldest]], static_cast<int>(next[oldest]));
+    ++next[oldest];
+    switch (oldest) {
+      case 0:
+        sync.add<0>(m);
+        break;
+      case 1:
+        sync.add<1>(m);
+        break;
+      default:
+        sync.add<2>(m);
+        break;
+    }
+  }
+
+  // Fed in stamp order, every greedy tuple spans at most the window; the reference is held to
+  // the same bound on the spread of a tuple
+  Batch3 batch(100);
+  batch.setMaxIntervalDuration(rclcpp::Duration::from_nanoseconds(window));
+  Tuples approximate;
+  for (const auto & indices : batch.match(stamps)) {
+    approximate.push_back(
+      {static_cast<int64_t>(indices[0]), static_cast<int64_t>(indices[1]),
+        static_cast<int64_t>(indices[2])});
+  }
+  std::set<std::vector<int64_t>> approximate_set(approximate.begin(), approximate.end());
+  std::size_t same = 0;
+  for (const auto & t : h.out_) {
+    same += approximate_set.count(t);
+  }
+
+  RecordProperty("greedy_tuples", static_cast<int>(h.out_.size()));
+  RecordProperty("approximate_tuples", static_cast<int>(approximate.size()));
+  RecordProperty("identical_tuples", static_cast<int>(same));
+  RecordProperty("greedy_mean_spread_ns", std::to_string(meanSpread(stamps, h.out_)));
+  RecordProperty("approximate_mean_spread_ns", std::to_string(meanSpread(stamps, approximate)));
+
+  // Every tuple spans at most the window
+  for (const auto & t : h.out_) {
+    std::array<int64_t, 3> s = {stamps[0][t[0]], stamps[1][t[1]], stamps[2][t[2]]};
+    EXPECT_LE(*std::max_element(s.begin(), s.end()) - *std::min_element(s.begin(), s.end()),
+      window);
+  }
+  // It finds nearly as many tuples, if not the same ones
+  EXPECT_GE(h.out_.size() * 10, approximate.size() * 8);
+  EXPECT_GT(same, 0u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -30,6 +30,7 @@
 
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <thread>
@@ -153,6 +154,66 @@ TEST_F(LatestTimePolicy, Leading)
   }
 }
 
+TEST_F(LatestTimePolicy, ReceiptTime)
+{
+  // Same as Leading, but the rates come from the receipt times, so there is no need to sleep
+  typedef message_filters::MessageEvent<Msg const> Event;
+  const int64_t period = 20000000;
+  for (std::size_t idx = 0U; idx < 8U; ++idx) {
+    rclcpp::Time t(static_cast<int64_t>(idx) * period, RCL_SYSTEM_TIME);
+    if (idx % 2U == 0U) {
+      sync.add<1>(Event(q[idx / 2U], t));
+    }
+    if (idx % 4U == 0U) {
+      sync.add<2>(Event(r[idx / 4U], t + rclcpp::Duration(0, 1000)));
+    }
+    sync.add<0>(Event(p[idx], t + rclcpp::Duration(0, 2000)));
+
+    EXPECT_EQ(h.count_, idx);
+    if (idx > 0) {
+      EXPECT_EQ(h.p_->data, p[idx]->data);
+      EXPECT_EQ(h.q_->data, q[idx / 2U]->data);
+      EXPECT_EQ(h.r_->data, r[idx / 4U]->data);
+    } else {
+      EXPECT_FALSE(h.p_);
+      EXPECT_FALSE(h.q_);
+      EXPECT_FALSE(h.r_);
+    }
+  }
+}
+
+TEST_F(LatestTimePolicy, SetClockAfterMessages)
+{
+  // Rates first measured with a ROS clock are forgotten when switching to the receipt times,
+  // whose times cannot be compared with them
+  typedef message_filters::MessageEvent<Msg const> Event;
+  sync.setClock(std::make_shared<rclcpp::Clock>(RCL_ROS_TIME));
+  sync.add<1>(q[0]);
+  sync.add<2>(r[0]);
+  sync.add<0>(p[0]);
+  sync.setClock(nullptr);
+
+  // Then it behaves as ReceiptTime does from the start
+  const int64_t period = 20000000;
+  for (std::size_t idx = 0U; idx < 8U; ++idx) {
+    rclcpp::Time t(static_cast<int64_t>(idx) * period, RCL_SYSTEM_TIME);
+    if (idx % 2U == 0U) {
+      sync.add<1>(Event(q[idx / 2U], t));
+    }
+    if (idx % 4U == 0U) {
+      sync.add<2>(Event(r[idx / 4U], t + rclcpp::Duration(0, 1000)));
+    }
+    sync.add<0>(Event(p[idx], t + rclcpp::Duration(0, 2000)));
+
+    EXPECT_EQ(h.count_, idx);
+    if (idx > 0) {
+      EXPECT_EQ(h.p_->data, p[idx]->data);
+      EXPECT_EQ(h.q_->data, q[idx / 2U]->data);
+      EXPECT_EQ(h.r_->data, r[idx / 4U]->data);
+    }
+  }
+}
+
 TEST_F(LatestTimePolicy, Trailing)
 {
   rclcpp::Rate rate(50.0);
@@ -0,0 +1,121 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "message_filters/lock_free_queue.hpp"
+
+TEST(LockFreeQueue, capacityIsRoundedUp)
+{
+  message_filters::LockFreeQueue<int> queue(5);
+  EXPECT_EQ(queue.capacity(), 8u);
+}
+
+TEST(LockFreeQueue, fifoUntilFull)
+{
+  message_filters::LockFreeQueue<int> queue(4);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.front(), nullptr);
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.tryPush(i));
+  }
+  EXPECT_FALSE(queue.tryPush(4));
+  ASSERT_NE(queue.front(), nullptr);
+  EXPECT_EQ(*queue.front(), 0);
+
+  int value = -1;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.tryPop(value));
+  EXPECT_TRUE(queue.empty());
+
+  // Wrap around the ring
+  EXPECT_TRUE(queue.tryPush(5));
+  ASSERT_TRUE(queue.tryPop(value));
+  EXPECT_EQ(value, 5);
+}
+
+TEST(LockFreeQueue, releasesPoppedValues)
+{
+  message_filters::LockFreeQueue<std::shared_ptr<int>> queue(2);
+  std::shared_ptr<int> value = std::make_shared<int>(1);
+  std::weak_ptr<int> weak = value;
+  EXPECT_TRUE(queue.tryPush(value));
+  value.reset();
+  std::shared_ptr<int> popped;
+  ASSERT_TRUE(queue.tryPop(popped));
+  popped.reset();
+  EXPECT_TRUE(weak.expired());
+}
+
+TEST(LockFreeQueue, multipleProducers)
+{
+  const int producers = 4;
+  const int per_producer = 20000;
+  message_filters::LockFreeQueue<int> queue(64);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back(
+      [&queue, p]() {
+        for (int i = 0; i < per_producer; ++i) {
+          while (!queue.tryPush(p * per_producer + i)) {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+
+  // Each producer's values must come out in the order it pushed them
+  std::vector<int> next(producers, 0);
+  int received = 0;
+  while (received < producers * per_producer) {
+    int value;
+    if (!queue.tryPop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    int p = value / per_producer;
+    EXPECT_EQ(value % per_producer, next[p]);
+    next[p] = value % per_producer + 1;
+    ++received;
+  }
+
+  for (std::thread & t : threads) {
+    t.join();
+  }
+  EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,305 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+
+#include "message_filters/synchronizer.hpp"
+#include "message_filters/sync_policies/approximate_epsilon_time.hpp"
+#include "message_filters/sync_policies/approximate_time.hpp"
+#include "message_filters/sync_policies/exact_time.hpp"
+#include "message_filters/sync_policies/latest_time.hpp"
+#include "message_filters/message_event.hpp"
+#include "message_filters/message_traits.hpp"
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg & m)
+  {
+    return m.header.stamp;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
+// Counts every call to the global operator new in this test, so that allocations bypassing the
+// memory resource of a policy are caught too
+std::atomic<size_t> g_new_calls{0};
+
+void * operator new(std::size_t size)
+{
+  ++g_new_calls;
+  if (void * p = std::malloc(size > 0 ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+// Used by std::pmr::new_delete_resource()
+void * operator new(std::size_t size, std::align_val_t alignment)
+{
+  ++g_new_calls;
+  size_t align = static_cast<size_t>(alignment);
+  // The size must be a multiple of the alignment
+  size = (std::max<size_t>(size, 1) + align - 1) / align * align;
+  if (void * p = std::aligned_alloc(align, size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void * p, std::size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+// Forwards to the default resource and counts the number of allocations
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+  size_t allocations_{0};
+
+private:
+  void * do_allocate(size_t bytes, size_t alignment) override
+  {
+    ++allocations_;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void * p, size_t bytes, size_t alignment) override
+  {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+typedef message_filters::MessageEvent<Msg const> Event;
+
+// The receipt time is given, as making the event otherwise reads a clock, which allocates
+Event makeEvent(int64_t nanoseconds)
+{
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = rclcpp::Time(nanoseconds, RCL_ROS_TIME);
+  return Event(m, m->header.stamp);
+}
+
+typedef std::vector<std::pair<int, Event>> Messages;
+
+// The messages of makeMessages() follow a pattern repeating every 2310 ticks, which the
+// synchronizers have been through with queues already filled once they have seen two of them
+const int64_t WARM_TICKS = 2 * 2310;
+
+// Makes the messages of three inputs at different rates and with some jitter, so that matches,
+// drops and (for ApproximateTime) virtual moves all happen, from the tick first_tick to
+// last_tick. They are made ahead of feeding them, which then allocates nothing by itself.
+Messages makeMessages(int64_t first_tick, int64_t last_tick)
+{
+  const int64_t ms = 1000000;
+  Messages messages;
+  for (int64_t tick = first_tick; tick < last_tick; ++tick) {
+    int64_t jitter = (tick % 3) * ms / 10;
+    if (tick % 10 == 0) {
+      messages.emplace_back(0, makeEvent(tick * ms));
+    }
+    if (tick % 33 == 0) {
+      messages.emplace_back(1, makeEvent(tick * ms + jitter));
+    }
+    if (tick % 7 == 0) {
+      messages.emplace_back(2, makeEvent(tick * ms - jitter));
+    }
+  }
+  return messages;
+}
+
+template<class Sync>
+void feed(Sync & sync, const Messages & messages)
+{
+  for (const auto & message : messages) {
+    if (message.first == 0) {
+      sync.template add<0>(message.second);
+    } else if (message.first == 1) {
+      sync.template add<1>(message.second);
+    } else {
+      sync.template add<2>(message.second);
+    }
+  }
+}
+
+// Feeds the messages from the tick first_tick to last_tick
+// \return the number of calls to the global operator new made meanwhile
+template<class Sync>
+size_t feed(Sync & sync, int64_t first_tick, int64_t last_tick)
+{
+  Messages messages = makeMessages(first_tick, last_tick);
+  size_t before = g_new_calls;
+  feed(sync, messages);
+  return g_new_calls - before;
+}
+
+class Counter
+{
+public:
+  void cb()
+  {
+    ++count_;
+  }
+
+  int32_t count_{0};
+};
+
+TEST(MemoryResource, approximateTimeNoAllocationOnceWarm)
+{
+  typedef message_filters::sync_policies::ApproximateTime<Msg, Msg, Msg> Policy;
+  CountingResource resource;
+  message_filters::Synchronizer<Policy> sync(Policy(10, &resource));
+  sync.getPolicy()->setInterMessageLowerBound(0, rclcpp::Duration(0, 9000000));
+  sync.getPolicy()->setInterMessageLowerBound(1, rclcpp::Duration(0, 32000000));
+  sync.getPolicy()->setInterMessageLowerBound(2, rclcpp::Duration(0, 6000000));
+  Counter c;
+  sync.registerCallback(std::bind(&Counter::cb, &c));
+
+  EXPECT_GT(feed(sync, 0, WARM_TICKS), 0u);
+  size_t warm = resource.allocations_;
+  EXPECT_GT(warm, 0u);
+  int32_t warm_count = c.count_;
+  EXPECT_GT(warm_count, 0);
+
+  EXPECT_EQ(feed(sync, WARM_TICKS, 100000), 0u);
+  EXPECT_GT(c.count_, warm_count);
+  EXPECT_EQ(resource.allocations_, warm);
+}
+
+TEST(MemoryResource, exactTimeNoAllocationOnceWarm)
+{
+  typedef message_filters::sync_policies::ExactTime<Msg, Msg, Msg> Policy;
+  CountingResource resource;
+  message_filters::Synchronizer<Policy> sync(Policy(10, &resource));
+  Counter c;
+  sync.registerCallback(std::bind(&Counter::cb, &c));
+
+  EXPECT_GT(feed(sync, 0, WARM_TICKS), 0u);
+  size_t warm = resource.allocations_;
+  EXPECT_GT(warm, 0u);
+  int32_t warm_count = c.count_;
+  EXPECT_GT(warm_count, 0);
+
+  EXPECT_EQ(feed(sync, WARM_TICKS, 100000), 0u);
+  EXPECT_GT(c.count_, warm_count);
+  EXPECT_EQ(resource.allocations_, warm);
+}
+
+TEST(MemoryResource, approximateEpsilonTimeNoAllocationOnceWarm)
+{
+  typedef message_filters::sync_policies::ApproximateEpsilonTime<Msg, Msg, Msg> Policy;
+  CountingResource resource;
+  message_filters::Synchronizer<Policy> sync(
+    Policy(10, rclcpp::Duration(0, 5000000), &resource));
+  Counter c;
+  sync.registerCallback(std::bind(&Counter::cb, &c));
+
+  EXPECT_GT(feed(sync, 0, WARM_TICKS), 0u);
+  size_t warm = resource.allocations_;
+  EXPECT_GT(warm, 0u);
+  int32_t warm_count = c.count_;
+  EXPECT_GT(warm_count, 0);
+
+  EXPECT_EQ(feed(sync, WARM_TICKS, 100000), 0u);
+  EXPECT_GT(c.count_, warm_count);
+  EXPECT_EQ(resource.allocations_, warm);
+}
+
+TEST(MemoryResource, latestTimeNoAllocationOnceWarm)
+{
+  typedef message_filters::sync_policies::LatestTime<Msg, Msg, Msg> Policy;
+  CountingResource resource;
+  message_filters::Synchronizer<Policy> sync(
+    Policy(std::make_shared<rclcpp::Clock>(RCL_ROS_TIME), &resource));
+
+  EXPECT_GT(feed(sync, 0, WARM_TICKS), 0u);
+  size_t warm = resource.allocations_;
+  EXPECT_GT(warm, 0u);
+
+  EXPECT_EQ(feed(sync, WARM_TICKS, 10000), 0u);
+  EXPECT_EQ(resource.allocations_, warm);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,264 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/pass_through.hpp"
+#include "message_filters/shared_event_buffer.hpp"
+#include "message_filters/synchronizer.hpp"
+#include "message_filters/sync_policies/nearest_time.hpp"
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg & m)
+  {
+    return m.header.stamp;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
+typedef message_filters::sync_policies::NearestTime<Msg, Msg> Policy2;
+typedef message_filters::sync_policies::NearestTime<Msg, Msg, Msg> Policy3;
+typedef message_filters::Synchronizer<Policy2> Sync2;
+typedef message_filters::Synchronizer<Policy3> Sync3;
+
+typedef std::vector<std::vector<int64_t>> Tuples;
+
+// Records the stamps of the signaled and of the dropped tuples
+class Helper
+{
+public:
+  void cb2(const MsgConstPtr & p, const MsgConstPtr & s)
+  {
+    out_.push_back({stamp(p), stamp(s)});
+  }
+
+  void cb3(const MsgConstPtr & p, const MsgConstPtr & s1, const MsgConstPtr & s2)
+  {
+    out_.push_back({stamp(p), stamp(s1), stamp(s2)});
+  }
+
+  void dropcb2(const MsgConstPtr & p, const MsgConstPtr & s)
+  {
+    drops_.push_back({stamp(p), stamp(s)});
+  }
+
+  static int64_t stamp(const MsgConstPtr & m)
+  {
+    return m ? m->header.stamp.nanoseconds() : -1;
+  }
+
+  Tuples out_;
+  Tuples drops_;
+};
+
+MsgPtr makeMsg(int64_t stamp)
+{
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = rclcpp::Time(stamp);
+  return m;
+}
+
+TEST(NearestTime, nearestNeighbor)
+{
+  Sync2 sync(10);
+  Helper h;
+  sync.registerCallback(
+    std::bind(&Helper::cb2, &h, std::placeholders::_1, std::placeholders::_2));
+
+  sync.add<1>(makeMsg(0));
+  sync.add<0>(makeMsg(10));
+  // The later neighbor of 10 has not arrived yet
+  EXPECT_TRUE(h.out_.empty());
+
+  sync.add<1>(makeMsg(14));
+  EXPECT_EQ(h.out_, (Tuples{{10, 14}}));
+
+  sync.add<0>(makeMsg(20));
+  sync.add<0>(makeMsg(30));
+  sync.add<1>(makeMsg(26));
+  // 14 and 26 are equally near to 20, the earlier one wins
+  EXPECT_EQ(h.out_, (Tuples{{10, 14}, {20, 14}}));
+
+  sync.add<1>(makeMsg(40));
+  EXPECT_EQ(h.out_, (Tuples{{10, 14}, {20, 14}, {30, 26}}));
+
+  // A secondary message that is already known is used right away
+  sync.add<0>(makeMsg(38));
+  EXPECT_EQ(h.out_, (Tuples{{10, 14}, {20, 14}, {30, 26}, {38, 40}}));
+}
+
+TEST(NearestTime, everyPivotSignaled)
+{
+  Sync3 sync(100);
+  Helper h;
+  sync.registerCallback(
+    std::bind(
+      &Helper::cb3, &h, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+
+  // The pivot input is ten times faster than the others
+  for (int64_t t = 0; t <= 1000; t += 10) {
+    sync.add<0>(makeMsg(t));
+    if (t % 100 == 0) {
+      sync.add<1>(makeMsg(t + 3));
+    }
+    if (t % 100 == 50) {
+      sync.add<2>(makeMsg(t - 2));
+    }
+  }
+  sync.add<2>(makeMsg(1048));
+
+  ASSERT_EQ(h.out_.size(), 101u);
+  for (size_t n = 0; n < h.out_.size(); ++n) {
+    int64_t t = static_cast<int64_t>(n) * 10;
+    EXPECT_EQ(h.out_[n][0], t);
+    EXPECT_EQ(h.out_[n][1], (t + 47) / 100 * 100 + 3);
+    EXPECT_EQ(h.out_[n][2], std::max<int64_t>(48, (t + 2) / 100 * 100 + 48));
+  }
+}
+
+TEST(NearestTime, tolerance)
+{
+  Sync2 sync(10);
+  sync.setTolerance(rclcpp::Duration(0, 5));
+  Helper h;
+  sync.registerCallback(
+    std::bind(&Helper::cb2, &h, std::placeholders::_1, std::placeholders::_2));
+  sync.registerDropCallback(
+    std::bind(&Helper::dropcb2, &h, std::placeholders::_1, std::placeholders::_2));
+
+  sync.add<0>(makeMsg(10));
+  sync.add<0>(makeMsg(20));
+  sync.add<1>(makeMsg(24));
+  EXPECT_EQ(h.out_, (Tuples{{20, 24}}));
+  EXPECT_EQ(h.drops_, (Tuples{{10, -1}}));
+}
+
+TEST(NearestTime, stalledInput)
+{
+  Sync2 sync(2);
+  Helper h;
+  sync.registerCallback(
+    std::bind(&Helper::cb2, &h, std::placeholders::_1, std::placeholders::_2));
+
+  sync.add<1>(makeMsg(5));
+  sync.add<0>(makeMsg(10));
+  sync.add<0>(makeMsg(20));
+  EXPECT_TRUE(h.out_.empty());
+
+  // No later neighbor for the oldest pivot message, so it makes do with what it has
+  sync.add<0>(makeMsg(30));
+  EXPECT_EQ(h.out_, (Tuples{{10, 5}}));
+
+  sync.add<1>(makeMsg(22));
+  EXPECT_EQ(h.out_, (Tuples{{10, 5}, {20, 22}}));
+}
+
+TEST(NearestTime, sharedBuffers)
+{
+  // Two synchronizers over overlapping topics, reading a single copy of inputs 1 and 2
+  message_filters::PassThrough<Msg> pivot;
+  auto secondary1 = std::make_shared<message_filters::SharedEventBuffer<Msg>>(100);
+  auto secondary2 = std::make_shared<message_filters::SharedEventBuffer<Msg>>(100);
+
+  Sync2 sync2(10);
+  sync2.setSharedBuffer<1>(secondary1);
+  sync2.connectInput(pivot, *secondary1);
+  Sync3 sync3(10);
+  sync3.setSharedBuffer<1>(secondary1);
+  sync3.setSharedBuffer<2>(secondary2);
+  sync3.connectInput(pivot, *secondary1, *secondary2);
+
+  // Same inputs, with the policy's own buffers
+  Sync3 reference(10);
+
+  Helper h2, h3, href;
+  sync2.registerCallback(
+    std::bind(&Helper::cb2, &h2, std::placeholders::_1, std::placeholders::_2));
+  sync3.registerCallback(
+    std::bind(
+      &Helper::cb3, &h3, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+  reference.registerCallback(
+    std::bind(
+      &Helper::cb3, &href, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+
+  for (int64_t t = 0; t < 1000; t += 10) {
+    pivot.add(makeMsg(t));
+    reference.add<0>(makeMsg(t));
+    if (t % 30 == 0) {
+      secondary1->add(makeMsg(t + 7));
+      reference.add<1>(makeMsg(t + 7));
+    }
+    if (t % 50 == 20) {
+      secondary2->add(makeMsg(t + 1));
+      reference.add<2>(makeMsg(t + 1));
+    }
+  }
+
+  EXPECT_GT(href.out_.size(), 90u);
+  EXPECT_EQ(h3.out_, href.out_);
+  ASSERT_EQ(h2.out_.size(), 100u);
+  for (size_t n = 0; n < href.out_.size(); ++n) {
+    EXPECT_EQ(h2.out_[n][1], href.out_[n][1]);
+  }
+  // Only the messages some synchronizer may still pair are kept
+  EXPECT_LE(secondary1->size(), 2u);
+  EXPECT_LE(secondary2->size(), 2u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}
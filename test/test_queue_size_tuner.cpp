@@ -0,0 +1,98 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "message_filters/queue_size_tuner.hpp"
+
+namespace
+{
+constexpr int64_t MS = 1000000;
+
+// Feeds a 100 Hz input 0 and a 10 Hz input 1 over [begin, end), input 1 arriving lag late
+void feed(message_filters::QueueSizeTuner & tuner, int64_t begin, int64_t end, int64_t lag)
+{
+  for (int64_t t = begin; t < end; t += 10 * MS) {
+    tuner.observe(0, t);
+    if (t % (100 * MS) == 0 && t >= lag) {
+      tuner.observe(1, t - lag);
+    }
+  }
+}
+}  // namespace
+
+TEST(QueueSizeTuner, rates)
+{
+  message_filters::QueueSizeTuner tuner(2);
+  EXPECT_FALSE(tuner.ready());
+  EXPECT_EQ(tuner.queueSize(0), 0u);
+
+  feed(tuner, 0, 1000 * MS, 0);
+  ASSERT_TRUE(tuner.ready());
+  EXPECT_EQ(tuner.period(0), 10 * MS);
+  EXPECT_EQ(tuner.period(1), 100 * MS);
+  // Keep one period of the slow input, on top of the message being added and the rounding
+  EXPECT_EQ(tuner.span(), 100 * MS);
+  EXPECT_EQ(tuner.queueSize(0), 12u);
+  EXPECT_EQ(tuner.queueSize(1), 3u);
+  EXPECT_EQ(tuner.stampCount(), 12u);
+}
+
+TEST(QueueSizeTuner, lag)
+{
+  message_filters::QueueSizeTuner tuner(2);
+  feed(tuner, 0, 1000 * MS, 0);
+  feed(tuner, 1000 * MS, 2000 * MS, 300 * MS);
+  EXPECT_GE(tuner.lag(1), 290 * MS);
+  EXPECT_EQ(tuner.lag(0), 0);
+  EXPECT_GE(tuner.queueSize(0), 41u);
+  EXPECT_EQ(tuner.queueSize(1), 5u);
+
+  // The lag is gone, the sizes shrink back as the peak decays
+  feed(tuner, 2000 * MS, 3000 * MS, 0);
+  EXPECT_LT(tuner.queueSize(0), 41u);
+  EXPECT_GT(tuner.queueSize(0), 12u);
+  feed(tuner, 3000 * MS, 8000 * MS, 0);
+  EXPECT_EQ(tuner.lag(1), 0);
+  EXPECT_EQ(tuner.queueSize(0), 12u);
+}
+
+TEST(QueueSizeTuner, bounds)
+{
+  message_filters::QueueSizeTuner tuner(2, 5, 10);
+  feed(tuner, 0, 1000 * MS, 0);
+  EXPECT_EQ(tuner.queueSize(0), 10u);
+  EXPECT_EQ(tuner.queueSize(1), 5u);
+
+  // Out of order and duplicate stamps do not disturb the period
+  tuner.observe(0, 500 * MS);
+  tuner.observe(0, 990 * MS);
+  EXPECT_EQ(tuner.period(0), 10 * MS);
+}
@@ -0,0 +1,93 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "message_filters/ring_buffer.hpp"
+
+TEST(RingBuffer, fifo)
+{
+  message_filters::RingBuffer<int> buffer;
+  EXPECT_TRUE(buffer.empty());
+
+  // Interleave pushes and pops so that the elements wrap around the ring while it grows
+  int next_pushed = 0;
+  int next_popped = 0;
+  for (int round = 0; round < 50; ++round) {
+    for (int i = 0; i < 3; ++i) {
+      buffer.push_back(next_pushed++);
+    }
+    EXPECT_EQ(buffer.front(), next_popped);
+    buffer.pop_front();
+    ++next_popped;
+    EXPECT_EQ(buffer.back(), next_pushed - 1);
+  }
+  ASSERT_EQ(buffer.size(), static_cast<size_t>(next_pushed - next_popped));
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    EXPECT_EQ(buffer[i], next_popped + static_cast<int>(i));
+  }
+  EXPECT_EQ(buffer.capacity(), 128u);
+
+  message_filters::RingBuffer<int> copy;
+  copy = buffer;
+  ASSERT_EQ(copy.size(), buffer.size());
+  EXPECT_EQ(copy.front(), buffer.front());
+  EXPECT_EQ(copy.back(), buffer.back());
+
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(copy.size(), 100u);
+}
+
+TEST(RingBuffer, reusesSlots)
+{
+  message_filters::RingBuffer<int> buffer;
+  buffer.reserve(5);
+  EXPECT_EQ(buffer.capacity(), 8u);
+  for (int i = 0; i < 1000; ++i) {
+    buffer.push_back(i);
+    if (buffer.size() > 5) {
+      buffer.pop_front();
+    }
+  }
+  EXPECT_EQ(buffer.capacity(), 8u);
+  EXPECT_EQ(buffer.front(), 995);
+}
+
+TEST(RingBuffer, releasesPoppedElements)
+{
+  message_filters::RingBuffer<std::shared_ptr<int>> buffer;
+  std::shared_ptr<int> value = std::make_shared<int>(1);
+  std::weak_ptr<int> weak = value;
+  buffer.push_back(value);
+  value.reset();
+  buffer.pop_front();
+  EXPECT_TRUE(weak.expired());
+}
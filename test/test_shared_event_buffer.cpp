@@ -0,0 +1,169 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/shared_event_buffer.hpp"
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg & m)
+  {
+    return m.header.stamp;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
+typedef message_filters::SharedEventBuffer<Msg> Buffer;
+
+MsgPtr makeMsg(int64_t stamp)
+{
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = rclcpp::Time(stamp);
+  return m;
+}
+
+TEST(SharedEventBuffer, independentCursors)
+{
+  auto buffer = std::make_shared<Buffer>(0);
+  buffer->add(makeMsg(1));
+  // Nobody reads it
+  EXPECT_EQ(buffer->size(), 0u);
+
+  Buffer::Cursor a(buffer);
+  buffer->add(makeMsg(2));
+  Buffer::Cursor b(buffer);
+  buffer->add(makeMsg(3));
+  buffer->add(makeMsg(4));
+  EXPECT_EQ(buffer->size(), 3u);
+
+  {
+    auto lock = a.lock();
+    ASSERT_EQ(a.size(), 3u);
+    EXPECT_EQ(a.stamp(0), 2);
+    EXPECT_EQ(a.stamp(2), 4);
+    EXPECT_EQ(a.event(1).getMessage()->header.stamp.nanoseconds(), 3);
+    ASSERT_EQ(b.size(), 2u);
+    EXPECT_EQ(b.stamp(0), 3);
+
+    // 2 is still needed by nobody else
+    a.pop_front();
+    a.pop_front();
+    EXPECT_EQ(a.stamp(0), 4);
+  }
+  // 3 is still needed by b
+  EXPECT_EQ(buffer->size(), 2u);
+
+  {
+    auto lock = b.lock();
+    b.pop_front();
+    b.pop_front();
+    EXPECT_EQ(b.size(), 0u);
+  }
+  EXPECT_EQ(buffer->size(), 1u);
+
+  // A copy starts where the original is
+  Buffer::Cursor c(a);
+  {
+    auto lock = a.lock();
+    a.pop_front();
+    EXPECT_EQ(c.size(), 1u);
+    EXPECT_EQ(c.stamp(0), 4);
+  }
+  EXPECT_EQ(buffer->size(), 1u);
+}
+
+TEST(SharedEventBuffer, capacity)
+{
+  auto buffer = std::make_shared<Buffer>(2);
+  Buffer::Cursor cursor(buffer);
+  for (int64_t stamp = 1; stamp <= 5; ++stamp) {
+    buffer->add(makeMsg(stamp));
+  }
+  EXPECT_EQ(buffer->size(), 2u);
+
+  // The cursor resumes at the oldest message left
+  auto lock = cursor.lock();
+  ASSERT_EQ(cursor.size(), 2u);
+  EXPECT_EQ(cursor.stamp(0), 4);
+  EXPECT_EQ(cursor.stamp(1), 5);
+}
+
+TEST(SharedEventBuffer, passThrough)
+{
+  auto buffer = std::make_shared<Buffer>(0);
+  Buffer::Cursor cursor(buffer);
+  int count = 0;
+  size_t buffered = 0;
+  buffer->registerCallback(
+    std::function<void(const MsgConstPtr &)>(
+      [&](const MsgConstPtr &) {
+        ++count;
+        auto lock = cursor.lock();
+        buffered = cursor.size();
+      }));
+
+  buffer->add(makeMsg(5));
+  EXPECT_EQ(count, 1);
+  EXPECT_EQ(buffered, 1u);
+
+  // Passed on, but not buffered
+  buffer->add(makeMsg(4));
+  EXPECT_EQ(count, 2);
+  EXPECT_EQ(buffered, 1u);
+  EXPECT_EQ(buffer->getOutOfOrderCount(), 1u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,249 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/pass_through.hpp"
+#include "message_filters/sync_group.hpp"
+#include "message_filters/synchronizer.hpp"
+#include "message_filters/sync_policies/exact_time.hpp"
+#include "message_filters/time_sequencer.hpp"
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg & m)
+  {
+    return m.header.stamp;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
+typedef message_filters::sync_policies::ExactTime<Msg, Msg> Policy2;
+typedef message_filters::Synchronizer<Policy2> Sync2;
+
+// Waits up to a second for <done> to hold
+template<class F>
+bool waitFor(F done)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (!done()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+class Helper
+{
+public:
+  void cb()
+  {
+    thread_ = std::this_thread::get_id();
+    ++count_;
+  }
+
+  void seqcb(const MsgConstPtr &)
+  {
+    ++count_;
+  }
+
+  std::thread::id thread_;
+  std::atomic<int> count_{0};
+};
+
+TEST(SyncGroup, workOfAMemberRunsInOrder)
+{
+  message_filters::SyncGroup group(2);
+  ASSERT_EQ(group.getThreadCount(), 2u);
+
+  const int members = 5;
+  const int posts = 1000;
+  std::vector<message_filters::SyncGroup::MemberId> ids;
+  std::vector<int> next(members, 0);
+  std::vector<int> running(members, 0);
+  std::atomic<int> out_of_order{0};
+  std::atomic<int> done{0};
+  for (int m = 0; m < members; ++m) {
+    ids.push_back(group.join());
+  }
+  for (int k = 0; k < posts; ++k) {
+    for (int m = 0; m < members; ++m) {
+      group.post(
+        ids[m], [&, m, k]() {
+          if (++running[m] != 1 || next[m] != k) {
+            ++out_of_order;
+          }
+          next[m] = k + 1;
+          --running[m];
+          ++done;
+        });
+    }
+  }
+  ASSERT_TRUE(waitFor([&done]() {return done == members * posts;}));
+  EXPECT_EQ(out_of_order, 0);
+}
+
+TEST(SyncGroup, leaveDiscardsPendingWork)
+{
+  message_filters::SyncGroup group(1);
+  auto member = group.join();
+  std::atomic<bool> started{false};
+  std::atomic<bool> finished{false};
+  std::atomic<bool> discarded_ran{false};
+  group.post(
+    member, [&]() {
+      started = true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      finished = true;
+    });
+  group.post(member, [&]() {discarded_ran = true;});
+  ASSERT_TRUE(waitFor([&started]() {return started.load();}));
+
+  // Waits for the running work, and drops the rest
+  group.leave(member);
+  EXPECT_TRUE(finished);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(discarded_ran);
+}
+
+TEST(SyncGroup, timers)
+{
+  // One worker, so that the callbacks of both timers run in the order they fired
+  message_filters::SyncGroup group(1, std::chrono::milliseconds(1));
+  auto fast = group.join();
+  auto slow = group.join();
+  std::atomic<int> fast_count{0};
+  std::atomic<int> slow_count{0};
+  std::atomic<int> fast_count_at_slow{-1};
+  auto start = std::chrono::steady_clock::now();
+  std::atomic<std::chrono::steady_clock::duration> slow_delay{};
+  group.addTimer(fast, std::chrono::milliseconds(5), [&fast_count]() {++fast_count;});
+  // Longer than a turn of the wheel
+  group.addTimer(
+    slow, std::chrono::milliseconds(300),
+    [&slow_count, &fast_count, &fast_count_at_slow, &slow_delay, start]() {
+      if (slow_count == 0) {
+        fast_count_at_slow = fast_count.load();
+        slow_delay = std::chrono::steady_clock::now() - start;
+      }
+      ++slow_count;
+    });
+
+  ASSERT_TRUE(waitFor([&slow_count]() {return slow_count >= 1;}));
+  // The fast timer fired, and its callback ran, before the slow one, which did not fire a turn
+  // of the wheel early
+  EXPECT_GE(fast_count_at_slow, 1);
+  EXPECT_GE(slow_delay.load(), std::chrono::milliseconds(299));
+
+  // Nothing of a member runs once it has left, however often its timer would have fired since
+  group.leave(fast);
+  int count = fast_count;
+  ASSERT_TRUE(waitFor([&slow_count]() {return slow_count >= 2;}));
+  EXPECT_EQ(fast_count, count);
+}
+
+TEST(SyncGroup, synchronizersRunOnWorkers)
+{
+  message_filters::SyncGroup group(2);
+  message_filters::PassThrough<Msg> f0[4], f1[4];
+  std::vector<std::unique_ptr<Sync2>> syncs;
+  Helper h[4];
+  for (int s = 0; s < 4; ++s) {
+    syncs.push_back(std::make_unique<Sync2>(Policy2(10), f0[s], f1[s]));
+    syncs.back()->joinGroup(group);
+    syncs.back()->registerCallback(std::bind(&Helper::cb, &h[s]));
+  }
+
+  for (int k = 0; k < 100; ++k) {
+    MsgPtr m(std::make_shared<Msg>());
+    m->header.stamp = rclcpp::Time(k);
+    for (int s = 0; s < 4; ++s) {
+      f0[s].add(m);
+      f1[s].add(m);
+    }
+  }
+  for (int s = 0; s < 4; ++s) {
+    ASSERT_TRUE(waitFor([&h, s]() {return h[s].count_ == 100;}));
+    EXPECT_NE(h[s].thread_, std::this_thread::get_id());
+  }
+
+  // Leaving the group on destruction stops the work still queued for it
+  syncs.clear();
+}
+
+TEST(SyncGroup, timeSequencerUsesGroupTimer)
+{
+  message_filters::SyncGroup group(1);
+  message_filters::TimeSequencer<Msg> seq(
+    rclcpp::Duration(0, 50000000), rclcpp::Duration(0, 10000000), 10, group);
+  Helper h;
+  seq.registerCallback(std::bind(&Helper::seqcb, &h, std::placeholders::_1));
+  MsgPtr msg(std::make_shared<Msg>());
+  msg->header.stamp = rclcpp::Clock().now();
+  seq.add(msg);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(h.count_, 0);
+  ASSERT_TRUE(waitFor([&h]() {return h.count_ == 1;}));
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -29,10 +29,21 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <rclcpp/rclcpp.hpp>
+#include "message_filters/pass_through.hpp"
 #include "message_filters/synchronizer.hpp"
+#include "message_filters/sync_policies/approximate_epsilon_time.hpp"
+#include "message_filters/sync_policies/exact_time.hpp"
+#include "message_filters/sync_policies/nearest_time.hpp"
 
 struct Header
 {
@@ -48,6 +59,21 @@ struct Msg
 typedef std::shared_ptr<Msg> MsgPtr;
 typedef std::shared_ptr<Msg const> MsgConstPtr;
 
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg & m)
+  {
+    return m.header.stamp;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
 
 template<typename M0, typename M1, typename M2 = message_filters::NullType,
   typename M3 = message_filters::NullType, typename M4 = message_filters::NullType,
@@ -91,6 +117,13 @@ typedef NullPolicy<Msg, Msg, Msg, Msg, Msg, Msg, Msg> Policy7;
 typedef NullPolicy<Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg> Policy8;
 typedef NullPolicy<Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg> Policy9;
 
+typedef message_filters::Synchronizer<message_filters::sync_policies::ExactTime<Msg, Msg>>
+  ExactSync2;
+typedef message_filters::sync_policies::ApproximateEpsilonTime<Msg, Msg> EpsilonPolicy2;
+typedef message_filters::Synchronizer<EpsilonPolicy2> EpsilonSync2;
+typedef message_filters::Synchronizer<message_filters::sync_policies::NearestTime<Msg, Msg>>
+  NearestSync2;
+
 TEST(Synchronizer, compile2)
 {
   message_filters::NullFilter<Msg> f0, f1;
@@ -469,6 +502,409 @@ TEST(Synchronizer, add9)
   ASSERT_EQ(sync.added_[8], 1);
 }
 
+template<class Sync>
+struct ReentrantHelper
+{
+  explicit ReentrantHelper(Sync & sync)
+  : sync_(sync)
+  {}
+
+  void callback(const MsgConstPtr & p, const MsgConstPtr &)
+  {
+    EXPECT_FALSE(in_callback_);
+    in_callback_ = true;
+    delivered_.push_back(p->data);
+    if (p->data == 1) {
+      // Adding from the callback would deadlock if it ran under the policy lock.
+      // The tuple it completes is delivered once this callback has returned.
+      MsgPtr m(std::make_shared<Msg>());
+      m->header.stamp = rclcpp::Time(0, 200000000, RCL_ROS_TIME);
+      m->data = 2;
+      sync_.template add<0>(m);
+      sync_.template add<1>(m);
+      EXPECT_EQ(delivered_.size(), 1u);
+    }
+    in_callback_ = false;
+  }
+
+  Sync & sync_;
+  std::vector<int> delivered_;
+  bool in_callback_{false};
+};
+
+template<class Sync>
+void checkCallbackRunsOutsideLock(Sync & sync)
+{
+  ReentrantHelper<Sync> h(sync);
+  sync.registerCallback(&ReentrantHelper<Sync>::callback, &h);
+
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = rclcpp::Time(0, 100000000, RCL_ROS_TIME);
+  m->data = 1;
+  sync.template add<0>(m);
+  sync.template add<1>(m);
+
+  ASSERT_EQ(h.delivered_.size(), 2u);
+  EXPECT_EQ(h.delivered_[0], 1);
+  EXPECT_EQ(h.delivered_[1], 2);
+}
+
+TEST(Synchronizer, callbackRunsOutsideLock)
+{
+  ExactSync2 exact(2);
+  checkCallbackRunsOutsideLock(exact);
+
+  EpsilonSync2 epsilon(EpsilonPolicy2(2, rclcpp::Duration(0, 1000)));
+  checkCallbackRunsOutsideLock(epsilon);
+}
+
+// Records matched tuples by their data and dropped ones by their negated data
+template<class Sync>
+struct DropOrderHelper
+{
+  explicit DropOrderHelper(Sync & sync)
+  : sync_(sync)
+  {}
+
+  void callback(const MsgConstPtr & p, const MsgConstPtr &)
+  {
+    events_.push_back(p->data);
+  }
+
+  void dropCallback(const MsgConstPtr & p, const MsgConstPtr &)
+  {
+    events_.push_back(-p->data);
+    if (events_.size() == 1) {
+      // Adding from the drop callback would deadlock if it ran under the policy lock
+      MsgPtr m(std::make_shared<Msg>());
+      m->header.stamp = rclcpp::Time(1000);
+      m->data = 1000;
+      sync_.template add<0>(m);
+    }
+  }
+
+  Sync & sync_;
+  std::vector<int> events_;
+};
+
+template<class Sync>
+void addStamp(Sync & sync, int input, int stamp)
+{
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = rclcpp::Time(stamp);
+  m->data = stamp;
+  if (input == 0) {
+    sync.template add<0>(m);
+  } else {
+    sync.template add<1>(m);
+  }
+}
+
+TEST(Synchronizer, dropCallbackRunsOutsideLock)
+{
+  // The older tuples are dropped once a newer one is matched, and reported after it
+  ExactSync2 exact(10);
+  DropOrderHelper<ExactSync2> exact_helper(exact);
+  exact.registerCallback(&DropOrderHelper<ExactSync2>::callback, &exact_helper);
+  exact.getPolicy()->registerDropCallback(
+    &DropOrderHelper<ExactSync2>::dropCallback, &exact_helper);
+  addStamp(exact, 0, 1);
+  addStamp(exact, 0, 2);
+  addStamp(exact, 0, 3);
+  addStamp(exact, 1, 3);
+  EXPECT_EQ(exact_helper.events_, (std::vector<int>{3, -1, -2}));
+
+  // The pivot without a message of the other input within the tolerance is dropped first
+  NearestSync2 nearest(10);
+  nearest.getPolicy()->setTolerance(rclcpp::Duration(0, 10));
+  DropOrderHelper<NearestSync2> nearest_helper(nearest);
+  nearest.registerCallback(&DropOrderHelper<NearestSync2>::callback, &nearest_helper);
+  nearest.getPolicy()->registerDropCallback(
+    &DropOrderHelper<NearestSync2>::dropCallback, &nearest_helper);
+  addStamp(nearest, 0, 100);
+  addStamp(nearest, 0, 195);
+  addStamp(nearest, 1, 200);
+  EXPECT_EQ(nearest_helper.events_, (std::vector<int>{-100, 195}));
+}
+
+TEST(Synchronizer, ingestionQueues)
+{
+  const int count = 1000;
+  message_filters::PassThrough<Msg> f0, f1;
+  ExactSync2 sync(0);
+  sync.enableIngestionQueues(count);
+  sync.connectInput(f0, f1);
+  std::atomic<int> matched{0};
+  std::thread::id matcher;
+  sync.registerCallback(
+    std::bind(
+      [&matched, &matcher]() {
+        matcher = std::this_thread::get_id();
+        ++matched;
+      }));
+
+  // Both inputs are fed concurrently; every stamp must still be matched exactly once
+  auto produce = [count](message_filters::PassThrough<Msg> & f) {
+      for (int i = 1; i <= count; ++i) {
+        MsgPtr m(std::make_shared<Msg>());
+        m->header.stamp = rclcpp::Time(i * 1000000LL);
+        f.add(m);
+      }
+    };
+  std::thread t0(produce, std::ref(f0));
+  std::thread t1(produce, std::ref(f1));
+  t0.join();
+  t1.join();
+
+  // The matcher thread catches up with the producers
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (matched < count && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(sync.getIngestionDropCount(0), 0u);
+  EXPECT_EQ(sync.getIngestionDropCount(1), 0u);
+  EXPECT_EQ(matched, count);
+  EXPECT_NE(matcher, std::this_thread::get_id());
+}
+
+struct CountHelper
+{
+  void cb()
+  {
+    ++count_;
+  }
+
+  int32_t count_{0};
+};
+
+struct BatchHelper
+{
+  void cb(const ExactSync2::Batch & batch)
+  {
+    std::vector<int64_t> stamps;
+    for (const auto & events : batch) {
+      stamps.push_back(std::get<0>(events).getMessage()->header.stamp.nanoseconds());
+    }
+    batches_.push_back(stamps);
+  }
+
+  std::vector<std::vector<int64_t>> batches_;
+};
+
+TEST(Synchronizer, batchSize)
+{
+  ExactSync2 sync(10);
+  sync.enableBatching(3);
+  CountHelper h;
+  BatchHelper bh;
+  sync.registerCallback(std::bind(&CountHelper::cb, &h));
+  sync.registerBatchCallback(std::bind(&BatchHelper::cb, &bh, std::placeholders::_1));
+
+  for (int64_t i = 1; i <= 7; ++i) {
+    MsgPtr m(std::make_shared<Msg>());
+    m->header.stamp = rclcpp::Time(i);
+    sync.add<0>(m);
+    sync.add<1>(m);
+  }
+  EXPECT_EQ(bh.batches_, (std::vector<std::vector<int64_t>>{{1, 2, 3}, {4, 5, 6}}));
+
+  sync.flushBatch();
+  EXPECT_EQ(bh.batches_, (std::vector<std::vector<int64_t>>{{1, 2, 3}, {4, 5, 6}, {7}}));
+  sync.flushBatch();
+  EXPECT_EQ(bh.batches_.size(), 3u);
+
+  // Batched tuples are not delivered one at a time
+  EXPECT_EQ(h.count_, 0);
+}
+
+TEST(Synchronizer, batchWindow)
+{
+  ExactSync2 sync(10);
+  sync.enableBatching(0, rclcpp::Duration(0, 100));
+  BatchHelper bh;
+  sync.registerBatchCallback(std::bind(&BatchHelper::cb, &bh, std::placeholders::_1));
+
+  for (int64_t stamp : {10, 50, 109, 110, 150, 300}) {
+    MsgPtr m(std::make_shared<Msg>());
+    m->header.stamp = rclcpp::Time(stamp);
+    sync.add<0>(m);
+    sync.add<1>(m);
+  }
+  EXPECT_EQ(bh.batches_, (std::vector<std::vector<int64_t>>{{10, 50, 109}, {110, 150}}));
+}
+
+TEST(Synchronizer, outputQueue)
+{
+  ExactSync2 sync(10);
+  sync.enableOutputQueue(4);
+  CountHelper h;
+  sync.registerCallback(std::bind(&CountHelper::cb, &h));
+
+  ExactSync2::Events events;
+  EXPECT_FALSE(sync.tryPop(events));
+  EXPECT_FALSE(sync.latest(events));
+
+  for (int64_t i = 1; i <= 6; ++i) {
+    MsgPtr m(std::make_shared<Msg>());
+    m->header.stamp = rclcpp::Time(i);
+    sync.add<0>(m);
+    sync.add<1>(m);
+  }
+  // Callbacks are still called
+  EXPECT_EQ(h.count_, 6);
+  // The two oldest made room for newer ones
+  EXPECT_EQ(sync.getOutputQueueDropCount(), 2u);
+
+  ASSERT_TRUE(sync.tryPop(events));
+  EXPECT_EQ(std::get<0>(events).getMessage()->header.stamp.nanoseconds(), 3);
+  EXPECT_EQ(std::get<1>(events).getMessage()->header.stamp.nanoseconds(), 3);
+  ASSERT_TRUE(sync.latest(events));
+  EXPECT_EQ(std::get<0>(events).getMessage()->header.stamp.nanoseconds(), 6);
+  EXPECT_FALSE(sync.tryPop(events));
+}
+
+TEST(Synchronizer, outputQueuePolling)
+{
+  const int count = 1000;
+  ExactSync2 sync(10);
+  sync.enableOutputQueue(8);
+
+  std::thread producer([&sync, count]() {
+      for (int i = 1; i <= count; ++i) {
+        MsgPtr m(std::make_shared<Msg>());
+        m->header.stamp = rclcpp::Time(i);
+        sync.add<0>(m);
+        sync.add<1>(m);
+      }
+    });
+
+  // Poll at our own pace; the stamps seen only ever increase
+  int64_t last = 0;
+  ExactSync2::Events events;
+  while (last < count) {
+    if (sync.latest(events)) {
+      int64_t stamp = std::get<0>(events).getMessage()->header.stamp.nanoseconds();
+      EXPECT_GT(stamp, last);
+      last = stamp;
+    }
+  }
+  producer.join();
+  EXPECT_EQ(last, count);
+}
+
+// Holds the callback for the tuple stamped 1 until open() is called
+class GatedHelper
+{
+public:
+  void cb(const MsgConstPtr & m, const MsgConstPtr &)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (m->header.stamp.nanoseconds() == 1) {
+      entered_ = true;
+      cond_.notify_all();
+      cond_.wait(lock, [this]() {return open_;});
+    }
+    stamps_.push_back(m->header.stamp.nanoseconds());
+  }
+
+  void waitEntered()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this]() {return entered_;});
+  }
+
+  void open()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    open_ = true;
+    cond_.notify_all();
+  }
+
+  std::vector<int64_t> stamps_;
+  bool entered_{false};
+  bool open_{false};
+  std::mutex mutex_;
+  std::condition_variable cond_;
+};
+
+void addTuple(ExactSync2 & sync, int64_t stamp)
+{
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = rclcpp::Time(stamp);
+  sync.add<0>(m);
+  sync.add<1>(m);
+}
+
+TEST(Synchronizer, outputLimitShedsTuples)
+{
+  auto run = [](message_filters::OutputOverflow overflow, GatedHelper & h) {
+      ExactSync2 sync(10);
+      sync.enableOutputLimit(2, overflow);
+      sync.registerCallback(&GatedHelper::cb, &h);
+
+      // While the callback is held, the tuples matched by this thread pile up
+      std::thread dispatcher([&sync]() {addTuple(sync, 1);});
+      h.waitEntered();
+      for (int64_t i = 2; i <= 6; ++i) {
+        addTuple(sync, i);
+      }
+      h.open();
+      dispatcher.join();
+      return sync.getShedCount();
+    };
+
+  GatedHelper drop_oldest;
+  EXPECT_EQ(run(message_filters::OutputOverflow::DropOldest, drop_oldest), 3u);
+  EXPECT_EQ(drop_oldest.stamps_, (std::vector<int64_t>{1, 5, 6}));
+
+  // Overflowing at 4 and again at 6 discards everything that was waiting each time
+  GatedHelper keep_latest;
+  EXPECT_EQ(run(message_filters::OutputOverflow::KeepLatest, keep_latest), 4u);
+  EXPECT_EQ(keep_latest.stamps_, (std::vector<int64_t>{1, 6}));
+}
+
+TEST(Synchronizer, outputLimitBlocksProducer)
+{
+  ExactSync2 sync(10);
+  sync.enableOutputLimit(2, message_filters::OutputOverflow::Block);
+  // Only used to see when the producer below has matched its tuple
+  sync.enableOutputQueue(4);
+  GatedHelper h;
+  sync.registerCallback(&GatedHelper::cb, &h);
+
+  std::thread dispatcher([&sync]() {addTuple(sync, 1);});
+  h.waitEntered();
+  addTuple(sync, 2);
+  addTuple(sync, 3);
+
+  // A third waiting tuple is one too many
+  std::atomic<bool> added{false};
+  std::thread producer([&sync, &added]() {
+      addTuple(sync, 4);
+      added = true;
+    });
+  ExactSync2::Events events;
+  while (!sync.latest(events) ||
+    std::get<0>(events).getMessage()->header.stamp.nanoseconds() != 4)
+  {
+    std::this_thread::yield();
+  }
+  // Tuple 4 is waiting behind the held callback, so the producer cannot have returned yet
+  EXPECT_FALSE(added);
+
+  h.open();
+  producer.join();
+  dispatcher.join();
+  EXPECT_TRUE(added);
+  EXPECT_EQ(h.stamps_, (std::vector<int64_t>{1, 2, 3, 4}));
+  EXPECT_EQ(sync.getShedCount(), 0u);
+
+  message_filters::CallbackStats stats = sync.getCallbackStats();
+  EXPECT_EQ(stats.calls, 4u);
+  EXPECT_GT(stats.max, std::chrono::steady_clock::duration::zero());
+  EXPECT_GE(stats.total, stats.max);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
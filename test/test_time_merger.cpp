@@ -0,0 +1,240 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/pass_through.hpp"
+#include "message_filters/time_merger.hpp"
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+
+struct OtherMsg
+{
+  Header header;
+  double value;
+};
+typedef std::shared_ptr<OtherMsg> OtherMsgPtr;
+typedef std::shared_ptr<OtherMsg const> OtherMsgConstPtr;
+
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg & m)
+  {
+    return m.header.stamp;
+  }
+};
+
+template<>
+struct TimeStamp<OtherMsg>
+{
+  static rclcpp::Time value(const OtherMsg & m)
+  {
+    return m.header.stamp;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
+typedef message_filters::TimeMerger<Msg, OtherMsg> Merger2;
+typedef message_filters::TimeMerger<Msg, Msg, Msg> Merger3;
+
+// Records (input index, stamp) in the order the messages are passed on
+class Helper
+{
+public:
+  void cb0(const MsgConstPtr & msg)
+  {
+    out_.emplace_back(0, msg->header.stamp.nanoseconds());
+  }
+
+  void cb1(const OtherMsgConstPtr & msg)
+  {
+    out_.emplace_back(1, msg->header.stamp.nanoseconds());
+  }
+
+  void cb2(const MsgConstPtr & msg)
+  {
+    out_.emplace_back(2, msg->header.stamp.nanoseconds());
+  }
+
+  std::vector<std::pair<int, int64_t>> out_;
+};
+
+MsgPtr makeMsg(int64_t stamp)
+{
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = rclcpp::Time(stamp);
+  return m;
+}
+
+OtherMsgPtr makeOtherMsg(int64_t stamp)
+{
+  OtherMsgPtr m(std::make_shared<OtherMsg>());
+  m->header.stamp = rclcpp::Time(stamp);
+  return m;
+}
+
+typedef std::vector<std::pair<int, int64_t>> Output;
+
+TEST(TimeMerger, watermark)
+{
+  Merger2 merger(0);
+  Helper h;
+  merger.registerCallback<0>(&Helper::cb0, &h);
+  merger.registerCallback<1>(&Helper::cb1, &h);
+
+  merger.add<0>(makeMsg(1));
+  merger.add<0>(makeMsg(3));
+  merger.add<0>(makeMsg(5));
+  // Input 1 has not received anything yet
+  EXPECT_TRUE(h.out_.empty());
+
+  merger.add<1>(makeOtherMsg(2));
+  EXPECT_EQ(h.out_, (Output{{0, 1}, {1, 2}}));
+
+  merger.add<1>(makeOtherMsg(5));
+  EXPECT_EQ(h.out_, (Output{{0, 1}, {1, 2}, {0, 3}, {0, 5}, {1, 5}}));
+
+  merger.add<1>(makeOtherMsg(7));
+  EXPECT_EQ(h.out_.size(), 5u);
+  merger.flush();
+  EXPECT_EQ(h.out_, (Output{{0, 1}, {1, 2}, {0, 3}, {0, 5}, {1, 5}, {1, 7}}));
+}
+
+TEST(TimeMerger, lateMessages)
+{
+  Merger2 merger(0);
+  Helper h;
+  merger.registerCallback<0>(&Helper::cb0, &h);
+  merger.registerCallback<1>(&Helper::cb1, &h);
+
+  merger.add<0>(makeMsg(10));
+  merger.add<1>(makeOtherMsg(10));
+  EXPECT_EQ(h.out_, (Output{{0, 10}, {1, 10}}));
+
+  // Older than what was passed on
+  merger.add<0>(makeMsg(9));
+  EXPECT_EQ(merger.getLateDropCount(), 1u);
+
+  // Out of order on its own input, but still in time
+  merger.add<0>(makeMsg(14));
+  merger.add<0>(makeMsg(12));
+  merger.add<1>(makeOtherMsg(20));
+  EXPECT_EQ(h.out_, (Output{{0, 10}, {1, 10}, {0, 12}, {0, 14}}));
+  EXPECT_EQ(merger.getLateDropCount(), 1u);
+}
+
+TEST(TimeMerger, queueOverflow)
+{
+  Merger2 merger(2);
+  Helper h;
+  merger.registerCallback<0>(&Helper::cb0, &h);
+  merger.registerCallback<1>(&Helper::cb1, &h);
+
+  merger.add<1>(makeOtherMsg(2));
+  merger.add<0>(makeMsg(1));
+  EXPECT_EQ(h.out_, (Output{{0, 1}}));
+
+  // Input 1 stalls, so input 0 overflows and is passed on without waiting for it
+  merger.add<0>(makeMsg(3));
+  merger.add<0>(makeMsg(4));
+  EXPECT_EQ(h.out_, (Output{{0, 1}, {1, 2}}));
+  merger.add<0>(makeMsg(5));
+  EXPECT_EQ(h.out_, (Output{{0, 1}, {1, 2}, {0, 3}}));
+
+  // Input 1 resumes behind what was passed on
+  merger.add<1>(makeOtherMsg(3));
+  merger.add<1>(makeOtherMsg(6));
+  EXPECT_EQ(h.out_, (Output{{0, 1}, {1, 2}, {0, 3}, {1, 3}, {0, 4}, {0, 5}}));
+  EXPECT_EQ(merger.getLateDropCount(), 0u);
+}
+
+TEST(TimeMerger, concurrentInputs)
+{
+  const int count = 1000;
+  message_filters::PassThrough<Msg> f0, f1, f2;
+  Merger3 merger(0, f0, f1, f2);
+  Helper h;
+  merger.registerCallback<0>(&Helper::cb0, &h);
+  merger.registerCallback<1>(
+    std::function<void(const MsgConstPtr &)>(
+      [&h](const MsgConstPtr & msg) {
+        h.out_.emplace_back(1, msg->header.stamp.nanoseconds());
+      }));
+  merger.registerCallback<2>(std::bind(&Helper::cb2, &h, std::placeholders::_1));
+
+  auto produce = [count](message_filters::PassThrough<Msg> & f, int offset) {
+      for (int i = 0; i < count; ++i) {
+        f.add(makeMsg(i * 3 + offset));
+      }
+    };
+  std::thread t0(produce, std::ref(f0), 0);
+  std::thread t1(produce, std::ref(f1), 1);
+  std::thread t2(produce, std::ref(f2), 2);
+  t0.join();
+  t1.join();
+  t2.join();
+  merger.flush();
+
+  // The stamps of the three inputs interleave, so the merged stream is 0, 1, 2, ...
+  ASSERT_EQ(h.out_.size(), 3u * count);
+  for (int i = 0; i < 3 * count; ++i) {
+    EXPECT_EQ(h.out_[i], std::make_pair(i % 3, static_cast<int64_t>(i)));
+  }
+  EXPECT_EQ(merger.getLateDropCount(), 0u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,218 @@
+// Copyright 2026, Open Source Robotics Foundation, Inc. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the Willow Garage nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/synchronizer.hpp"
+#include "message_filters/sync_policies/window_time.hpp"
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg & m)
+  {
+    return m.header.stamp;
+  }
+};
+}  // namespace message_traits
+}  // namespace message_filters
+
+typedef message_filters::sync_policies::WindowTime<Msg, Msg> Policy2;
+typedef message_filters::sync_policies::WindowTime<Msg, Msg, Msg> Policy3;
+typedef message_filters::Synchronizer<Policy2> Sync2;
+typedef message_filters::Synchronizer<Policy3> Sync3;
+
+typedef std::vector<std::vector<int64_t>> Windows;
+
+// Records the stamps of each window, pivot first
+class Helper
+{
+public:
+  void cb2(const Policy2::Window & w)
+  {
+    windows_.push_back(w);
+    std::vector<int64_t> stamps{stamp(std::get<0>(w))};
+    for (const auto & evt : std::get<1>(w)) {
+      stamps.push_back(stamp(evt));
+    }
+    out_.push_back(stamps);
+  }
+
+  template<class E>
+  static int64_t stamp(const E & evt)
+  {
+    return evt.getMessage()->header.stamp.nanoseconds();
+  }
+
+  Windows out_;
+  std::vector<Policy2::Window> windows_;
+};
+
+MsgPtr makeMsg(int64_t stamp)
+{
+  MsgPtr m(std::make_shared<Msg>());
+  m->header.stamp = rclcpp::Time(stamp);
+  return m;
+}
+
+TEST(WindowTime, sincePreviousPivot)
+{
+  Sync2 sync(100);
+  Helper h;
+  sync.registerWindowCallback(std::bind(&Helper::cb2, &h, std::placeholders::_1));
+
+  for (int64_t t = 0; t <= 20; t += 10) {
+    sync.add<1>(makeMsg(t));
+  }
+  sync.add<0>(makeMsg(25));
+  // 30 might still arrive stamped 25
+  EXPECT_TRUE(h.out_.empty());
+
+  sync.add<1>(makeMsg(30));
+  EXPECT_EQ(h.out_, (Windows{{25, 0, 10, 20}}));
+
+  sync.add<0>(makeMsg(50));
+  sync.add<0>(makeMsg(55));
+  for (int64_t t = 40; t <= 60; t += 10) {
+    sync.add<1>(makeMsg(t));
+  }
+  // Every secondary message is in exactly one window, and a window may be empty
+  EXPECT_EQ(h.out_, (Windows{{25, 0, 10, 20}, {50, 30, 40, 50}, {55}}));
+}
+
+TEST(WindowTime, aroundPivot)
+{
+  Sync2 sync(100);
+  sync.setWindow(rclcpp::Duration(0, 10), rclcpp::Duration(0, 5));
+  Helper h;
+  sync.registerWindowCallback(std::bind(&Helper::cb2, &h, std::placeholders::_1));
+
+  sync.add<0>(makeMsg(50));
+  sync.add<0>(makeMsg(52));
+  for (int64_t t = 30; t <= 55; t += 5) {
+    sync.add<1>(makeMsg(t));
+  }
+  // 55 is the end of the window of 50, which is only complete once a later message arrives
+  EXPECT_TRUE(h.out_.empty());
+  sync.add<1>(makeMsg(56));
+  EXPECT_EQ(h.out_, (Windows{{50, 40, 45, 50, 55}}));
+  sync.add<1>(makeMsg(60));
+  // The windows overlap
+  EXPECT_EQ(h.out_, (Windows{{50, 40, 45, 50, 55}, {52, 45, 50, 55, 56}}));
+}
+
+TEST(WindowTime, rangesOutliveBuffers)
+{
+  Sync2 sync(0);
+  Helper h;
+  sync.registerWindowCallback(std::bind(&Helper::cb2, &h, std::placeholders::_1));
+
+  MsgPtr first = makeMsg(0);
+  std::weak_ptr<Msg> first_weak = first;
+  sync.add<1>(first);
+  first.reset();
+  for (int64_t t = 1; t < 1000; ++t) {
+    sync.add<1>(makeMsg(t));
+    if (t % 100 == 50) {
+      sync.add<0>(makeMsg(t - 1));
+    }
+  }
+  ASSERT_EQ(h.windows_.size(), 10u);
+  // The windows kept by the helper still point to their own messages, although the buffer they
+  // point into was replaced several times since
+  for (size_t n = 0; n < h.windows_.size(); ++n) {
+    const auto & range = std::get<1>(h.windows_[n]);
+    ASSERT_EQ(range.size(), n == 0 ? 50u : 100u);
+    EXPECT_EQ(Helper::stamp(range.back()), static_cast<int64_t>(n * 100 + 49));
+    for (size_t k = 1; k < range.size(); ++k) {
+      EXPECT_EQ(Helper::stamp(range[k]), Helper::stamp(range[k - 1]) + 1);
+    }
+  }
+  EXPECT_FALSE(first_weak.expired());
+
+  // Once no window points to it, the first message is released with its buffer
+  h.windows_.clear();
+  for (int64_t t = 1000; t < 1100; ++t) {
+    sync.add<1>(makeMsg(t));
+  }
+  sync.add<0>(makeMsg(1050));
+  EXPECT_TRUE(first_weak.expired());
+}
+
+TEST(WindowTime, stalledInput)
+{
+  Sync3 sync(2);
+  std::vector<size_t> sizes;
+  sync.registerWindowCallback(
+    [&sizes](const Policy3::Window & w) {
+      sizes.push_back(std::get<1>(w).size());
+      sizes.push_back(std::get<2>(w).size());
+    });
+
+  sync.add<1>(makeMsg(5));
+  sync.add<1>(makeMsg(15));
+  sync.add<0>(makeMsg(10));
+  sync.add<0>(makeMsg(20));
+  EXPECT_TRUE(sizes.empty());
+  // Input 2 stalled: the oldest pivot message is delivered with what has been received
+  sync.add<0>(makeMsg(30));
+  EXPECT_EQ(sizes, (std::vector<size_t>{1, 0}));
+
+  // Input 1 went back in time
+  sync.add<1>(makeMsg(12));
+  EXPECT_EQ(sync.getLateDropCount(), 1u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  return RUN_ALL_TESTS();
+}